@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cassert>  // for assert
+#include <cstdint>  // for uint32_t
+#include <stddef.h> // for size_t
+#include <vector>   // for vector
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Alias table for O(1) sampling of a discrete distribution
+ *
+ * The `AliasTable` class samples index i with probability proportional to
+ * weight w_i in constant time (Walker's alias method, built with Vose's
+ * algorithm). To build tables of 10^8 weights in parallel, the weights are
+ * split into blocks of `BLOCK` entries: every block gets its own alias
+ * table, built on its own thread, and a small top-level table over the
+ * block totals picks the block. A sample is thus two alias lookups. A
+ * single uniform number drives both: the fraction left over by each
+ * lookup is rescaled to [0, 1) and reused, so the low-discrepancy
+ * structure of the input is kept as far as possible.
+ */
+class AliasTable {
+    size_t n;
+    vector<double> top_prob; // top level, one entry per block
+    vector<uint32_t> top_alias;
+    vector<double> prob; // per block, alias relative to the block
+    vector<uint32_t> alias;
+    double total;
+
+    /**
+     * @brief One alias lookup over the table at prob/alias of length len
+     *
+     * @param[in,out] u uniform in [0, 1), replaced by the unused fraction
+     */
+    static auto lookup(const double *p, const uint32_t *a, size_t len,
+                       double &u) -> size_t {
+        const auto x = u * double(len);
+        auto k = size_t(x);
+        k = k < len ? k : len - 1;
+        const auto f = x - double(k);
+        if (f < p[k]) {
+            u = f / p[k];
+            return k;
+        }
+        u = (f - p[k]) / (1.0 - p[k]);
+        return a[k];
+    }
+
+  public:
+    /** Number of weights per block */
+    static constexpr size_t BLOCK = 4096;
+
+    /**
+     * @brief Construct a new AliasTable object
+     *
+     * @param[in] weights nonnegative weights, not all zero
+     * @param[in] n number of weights
+     * @param[in] num_threads 0 for all hardware threads
+     */
+    AliasTable(const double *weights, size_t n, size_t num_threads = 0);
+
+    /**
+     * @brief Construct a new AliasTable object
+     *
+     * @param[in] weights nonnegative weights, not all zero
+     * @param[in] num_threads 0 for all hardware threads
+     */
+    explicit AliasTable(const vector<double> &weights, size_t num_threads = 0)
+        : AliasTable(weights.data(), weights.size(), num_threads) {}
+
+    /**
+     * @brief sample
+     *
+     * The `sample(double u, double &rest)` function maps the uniform number
+     * `u` in [0, 1) to an index, and sets `rest` to a fresh uniform number in
+     * [0, 1) made from the bits of `u` left unused, which can drive a
+     * further choice.
+     *
+     * @param[in] u
+     * @param[out] rest
+     * @return size_t
+     */
+    auto sample(double u, double &rest) const -> size_t {
+        const auto b = lookup(this->top_prob.data(), this->top_alias.data(),
+                              this->top_prob.size(), u);
+        const auto first = b * BLOCK;
+        const auto len = first + BLOCK < this->n ? BLOCK : this->n - first;
+        const auto k =
+            first + lookup(&this->prob[first], &this->alias[first], len, u);
+        rest = u;
+        return k;
+    }
+
+    /**
+     * @brief sample
+     *
+     * @param[in] u uniform in [0, 1)
+     * @return size_t
+     */
+    auto sample(double u) const -> size_t {
+        auto rest = 0.0;
+        return this->sample(u, rest);
+    }
+
+    /**
+     * @brief Sum of the weights
+     *
+     * @return double
+     */
+    auto sum() const -> double { return this->total; }
+
+    /**
+     * @brief Number of weights
+     *
+     * @return size_t
+     */
+    auto size() const -> size_t { return this->n; }
+};
+
+} // namespace lds2
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <algorithm> // for min
+#include <cassert>   // for assert
+#include <cmath>     // for pow, sqrt
+#include <stddef.h>  // for size_t
+#include <variant>   // for variant, get, visit
+#include <vector>    // for vector
+
+#include "lds.hpp"    // for VdCorput, Circle, Sphere
+#include "lds_n.hpp"  // for HaltonN
+#include "normal.hpp" // for inv_norm_cdf
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Ball and spherical shell sequence generator
+ *
+ * The `BallN` class generates points uniformly distributed in the shell
+ * r_inner <= |x| <= r_outer of R^dim (the ball when r_inner = 0). A point
+ * is a direction times a radius. The radius comes from its own `VdCorput`
+ * coordinate u: the volume within radius r grows as r^dim, so
+ * r = (r_inner^dim + u (r_outer^dim - r_inner^dim))^(1 / dim). The
+ * direction comes from `Circle` for dim = 2 and `Sphere` for dim = 3; for
+ * dim >= 4 it is the normalized vector of `dim` Gaussian coordinates
+ * obtained from `HaltonN` through `inv_norm_cdf()`. Only the direction
+ * generator of the chosen dim is built.
+ */
+class BallN {
+    using Direction = std::variant<Circle, Sphere, HaltonN>;
+
+    size_t dim;
+    VdCorput radius;
+    Direction direction; // Circle, Sphere or Gaussian coordinates
+    double lo;           // r_inner^dim
+    double span;         // r_outer^dim - r_inner^dim
+
+    static auto make_direction(size_t dim, const vector<size_t> &base)
+        -> Direction {
+        assert(dim >= 2 && base.size() == num_bases(dim));
+        if (dim == 2) {
+            return Circle(base[1]);
+        }
+        if (dim == 3) {
+            return Sphere(base[1], base[2]);
+        }
+        return HaltonN(vector<size_t>(base.begin() + 1, base.end()));
+    }
+
+    auto next_radius() -> double {
+        return std::pow(this->lo + this->radius.pop() * this->span,
+                        1.0 / double(this->dim));
+    }
+
+  public:
+    /**
+     * @brief Number of bases needed for a given dimension
+     *
+     * @param[in] dim
+     * @return size_t dim for dim <= 3, dim + 1 otherwise
+     */
+    static auto num_bases(size_t dim) -> size_t {
+        return dim <= 3 ? dim : dim + 1;
+    }
+
+    /**
+     * @brief Construct a new BallN object
+     *
+     * @param[in] dim dimension, >= 2
+     * @param[in] base `num_bases(dim)` bases, the first for the radius
+     * @param[in] r_inner
+     * @param[in] r_outer
+     */
+    BallN(size_t dim, const vector<size_t> &base, double r_inner = 0.0,
+          double r_outer = 1.0)
+        : dim{dim}, radius(base[0]),
+          direction(make_direction(dim, base)),
+          lo{std::pow(r_inner, double(dim))},
+          span{std::pow(r_outer, double(dim)) - this->lo} {
+        assert(0.0 <= r_inner && r_inner <= r_outer);
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function writes the next `num`
+     * points row by row into `out`, which must hold `num * dimension()`
+     * doubles. For dim >= 4 the Gaussian coordinates are generated and
+     * transformed in `out` itself, in one pass over the whole batch.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        if (this->dim == 2) {
+            auto &circle = std::get<Circle>(this->direction);
+            for (size_t k = 0; k != num; ++k, out += 2) {
+                const auto r = this->next_radius();
+                const auto c = circle.pop();
+                out[0] = r * c[0];
+                out[1] = r * c[1];
+            }
+            return;
+        }
+        if (this->dim == 3) {
+            auto &sphere = std::get<Sphere>(this->direction);
+            for (size_t k = 0; k != num; ++k, out += 3) {
+                const auto r = this->next_radius();
+                const auto s = sphere.pop();
+                out[0] = r * s[0];
+                out[1] = r * s[1];
+                out[2] = r * s[2];
+            }
+            return;
+        }
+        std::get<HaltonN>(this->direction).fill(out, num);
+        inv_norm_cdf(out, num * this->dim);
+        for (size_t k = 0; k != num; ++k, out += this->dim) {
+            auto norm2 = 0.0;
+            for (size_t j = 0; j != this->dim; ++j) {
+                norm2 += out[j] * out[j];
+            }
+            const auto scale = this->next_radius() / std::sqrt(norm2);
+            for (size_t j = 0; j != this->dim; ++j) {
+                out[j] *= scale;
+            }
+        }
+    }
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function returns the next point as a
+     * `std::vector<double>`.
+     *
+     * @return vector<double>
+     */
+    auto pop() -> vector<double> {
+        auto res = vector<double>(this->dim);
+        this->fill(res.data(), 1);
+        return res;
+    }
+
+    /**
+     * @brief Number of dimensions
+     *
+     * @return size_t
+     */
+    auto dimension() const -> size_t { return this->dim; }
+
+    /**
+     * @brief reseed
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void {
+        this->radius.reseed(seed);
+        std::visit([seed](auto &gen) { gen.reseed(seed); }, this->direction);
+    }
+};
+
+/**
+ * @brief Cube shell sequence generator
+ *
+ * The `CubeShellN` class generates points uniformly distributed in the
+ * shell between the cubes [-a_inner, a_inner]^dim and
+ * [-a_outer, a_outer]^dim. It is the max-norm counterpart of `BallN`: a
+ * point is a point of the surface of [-1, 1]^dim times a radius with the
+ * same r^dim law. The 2 dim faces have equal area, so one coordinate picks
+ * the face and dim - 1 coordinates place the point on it. A point consumes
+ * dim + 1 coordinates of a `HaltonN` sequence: radius, face, position.
+ */
+class CubeShellN {
+    HaltonN halton;
+    double lo;          // a_inner^dim
+    double span;        // a_outer^dim - a_inner^dim
+    vector<double> buf; // the dim + 1 uniforms of each point of a block
+
+    static constexpr size_t BLOCK = 256;
+
+  public:
+    /**
+     * @brief Construct a new CubeShellN object
+     *
+     * @param[in] dim dimension, >= 1
+     * @param[in] base dim + 1 bases
+     * @param[in] a_inner inner half side
+     * @param[in] a_outer outer half side
+     */
+    CubeShellN(size_t dim, const vector<size_t> &base, double a_inner,
+               double a_outer = 1.0)
+        : halton(base), lo{std::pow(a_inner, double(dim))},
+          span{std::pow(a_outer, double(dim)) - this->lo},
+          buf(BLOCK * (dim + 1)) {
+        assert(dim >= 1 && base.size() == dim + 1);
+        assert(0.0 <= a_inner && a_inner <= a_outer);
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function writes the next `num`
+     * points row by row into `out`, which must hold `num * dimension()`
+     * doubles. The uniforms are generated by `HaltonN::fill()` in blocks
+     * of `BLOCK` points, then mapped point by point.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        const auto dim = this->dimension();
+        const auto inv_dim = 1.0 / double(dim);
+        for (size_t i = 0; i < num; i += BLOCK) {
+            const auto len = std::min(BLOCK, num - i);
+            this->halton.fill(this->buf.data(), len);
+            const auto *u = this->buf.data();
+            for (size_t k = 0; k != len; ++k, u += dim + 1, out += dim) {
+                const auto r = std::pow(this->lo + u[0] * this->span, inv_dim);
+                auto face = size_t(u[1] * double(2 * dim));
+                face = face < 2 * dim ? face : 2 * dim - 1;
+                const auto axis = face / 2;
+                for (size_t j = 0, m = 2; j != dim; ++j) {
+                    out[j] = j == axis ? (face % 2 == 0 ? r : -r)
+                                       : r * (2.0 * u[m++] - 1.0);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function returns the next point as a
+     * `std::vector<double>`.
+     *
+     * @return vector<double>
+     */
+    auto pop() -> vector<double> {
+        auto res = vector<double>(this->dimension());
+        this->fill(res.data(), 1);
+        return res;
+    }
+
+    /**
+     * @brief Number of dimensions
+     *
+     * @return size_t
+     */
+    auto dimension() const -> size_t { return this->halton.dimension() - 1; }
+
+    /**
+     * @brief reseed
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void { this->halton.reseed(seed); }
+};
+
+} // namespace lds2
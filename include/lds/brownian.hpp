@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm> // for min
+#include <cassert>   // for assert
+#include <cmath>     // for sqrt
+#include <stddef.h>  // for size_t
+#include <vector>    // for vector
+
+#include "normal.hpp" // for fill_normal
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Brownian bridge path construction
+ *
+ * The `BrownianBridge` class turns a vector of independent N(0, 1) variates
+ * z_0, ..., z_{n-1} into a Brownian path W(t_1), ..., W(t_n). z_0 sets the
+ * terminal value W(t_n), z_1 the midpoint, and so on by bisection, so the
+ * first coordinates of a quasi-Monte Carlo point, which are the best
+ * distributed, drive the directions of largest variance. The bisection
+ * order, the indices of the two neighbouring known values and the
+ * interpolation weights are computed once in the constructor; each path
+ * then costs one fused multiply-add chain per step.
+ */
+class BrownianBridge {
+    size_t steps;
+    vector<size_t> bridge; // index filled at each stage
+    vector<size_t> left;   // left neighbour + 1, 0 for W(0) = 0
+    vector<size_t> right;  // right neighbour
+    vector<double> lweight;
+    vector<double> rweight;
+    vector<double> stddev;
+
+    static constexpr size_t BLOCK = 64; // paths per block in batch mode
+
+    static auto uniform_times(size_t steps, double horizon) -> vector<double> {
+        auto t = vector<double>(steps);
+        for (size_t i = 0; i != steps; ++i) {
+            t[i] = horizon * double(i + 1) / double(steps);
+        }
+        return t;
+    }
+
+  public:
+    /**
+     * @brief Construct a new BrownianBridge object
+     *
+     * @param[in] times increasing times t_1 < ... < t_n, with t_0 = 0
+     */
+    explicit BrownianBridge(const vector<double> &times)
+        : steps{times.size()}, bridge(steps), left(steps), right(steps),
+          lweight(steps), rweight(steps), stddev(steps) {
+        assert(this->steps >= 1);
+        const auto &t = times;
+        const auto n = this->steps;
+        auto map = vector<size_t>(n, 0);
+        map[n - 1] = 1;
+        this->bridge[0] = n - 1;
+        this->stddev[0] = std::sqrt(t[n - 1]);
+        for (size_t i = 1, j = 0; i != n; ++i) {
+            while (map[j] != 0) {
+                ++j;
+            }
+            auto k = j;
+            while (map[k] == 0) {
+                ++k;
+            }
+            // bisect the gap of unknown values j..k-1 between j-1 and k
+            const auto l = j + ((k - 1 - j) >> 1U);
+            map[l] = i;
+            this->bridge[i] = l;
+            this->left[i] = j;
+            this->right[i] = k;
+            const auto t0 = j != 0 ? t[j - 1] : 0.0;
+            this->lweight[i] = (t[k] - t[l]) / (t[k] - t0);
+            this->rweight[i] = (t[l] - t0) / (t[k] - t0);
+            this->stddev[i] = std::sqrt((t[l] - t0) * (t[k] - t[l]) /
+                                        (t[k] - t0));
+            j = k + 1 >= n ? 0 : k + 1;
+        }
+    }
+
+    /**
+     * @brief Construct a new BrownianBridge object on a uniform grid
+     *
+     * @param[in] steps number of time steps
+     * @param[in] horizon final time T, the steps being at T i / steps
+     */
+    BrownianBridge(size_t steps, double horizon)
+        : BrownianBridge(uniform_times(steps, horizon)) {}
+
+    /**
+     * @brief transform
+     *
+     * The `transform(const double *z, double *path)` function builds one
+     * path from the `steps` normal variates in `z`, writing W(t_1), ...,
+     * W(t_n) to `path`.
+     *
+     * @param[in] z
+     * @param[out] path
+     */
+    auto transform(const double *z, double *path) const -> void {
+        path[this->steps - 1] = this->stddev[0] * z[0];
+        for (size_t i = 1; i != this->steps; ++i) {
+            const auto j = this->left[i];
+            const auto wl = j != 0 ? this->lweight[i] * path[j - 1] : 0.0;
+            path[this->bridge[i]] = wl +
+                                    this->rweight[i] * path[this->right[i]] +
+                                    this->stddev[i] * z[i];
+        }
+    }
+
+    /**
+     * @brief transform
+     *
+     * The `transform(z, num, out, stride)` function builds `num` paths from
+     * the row-major normal variates `z` (`steps` per path) and writes them in
+     * structure-of-arrays layout: W(t_{l+1}) of path p goes to
+     * `out[l * stride + p]`, with `stride >= num`. Paths are processed in
+     * blocks, so that every bridge step is a contiguous loop over the paths
+     * of a block.
+     *
+     * @param[in] z
+     * @param[in] num
+     * @param[out] out
+     * @param[in] stride
+     */
+    auto transform(const double *z, size_t num, double *out,
+                   size_t stride) const -> void {
+        assert(stride >= num);
+        const auto n = this->steps;
+        auto zt = vector<double>(n * BLOCK);
+        for (size_t first = 0; first < num; first += BLOCK) {
+            const auto len = std::min(BLOCK, num - first);
+            for (size_t p = 0; p != len; ++p) { // transpose the block
+                for (size_t i = 0; i != n; ++i) {
+                    zt[i * BLOCK + p] = z[(first + p) * n + i];
+                }
+            }
+            auto *o = out + first;
+            {
+                auto *w = o + (n - 1) * stride;
+                const auto sd = this->stddev[0];
+                for (size_t p = 0; p != len; ++p) {
+                    w[p] = sd * zt[p];
+                }
+            }
+            for (size_t i = 1; i != n; ++i) {
+                auto *w = o + this->bridge[i] * stride;
+                const auto *wr = o + this->right[i] * stride;
+                const auto *zi = &zt[i * BLOCK];
+                const auto rw = this->rweight[i];
+                const auto sd = this->stddev[i];
+                if (this->left[i] == 0) {
+                    for (size_t p = 0; p != len; ++p) {
+                        w[p] = rw * wr[p] + sd * zi[p];
+                    }
+                } else {
+                    const auto *wl = o + (this->left[i] - 1) * stride;
+                    const auto lw = this->lweight[i];
+                    for (size_t p = 0; p != len; ++p) {
+                        w[p] = lw * wl[p] + rw * wr[p] + sd * zi[p];
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(gen, num, out, stride)` function draws `num` Gaussian points
+     * from the generator `gen` (e.g. a `HaltonN` with `steps` bases) through
+     * `fill_normal()` and builds one path from each, in the layout of
+     * `transform()`.
+     *
+     * @param[in,out] gen
+     * @param[in] num
+     * @param[out] out
+     * @param[in] stride
+     */
+    template <typename Gen>
+    auto fill(Gen &gen, size_t num, double *out, size_t stride) const
+        -> void {
+        assert(gen.dimension() == this->steps);
+        auto z = vector<double>(BLOCK * this->steps);
+        for (size_t first = 0; first < num; first += BLOCK) {
+            const auto len = std::min(BLOCK, num - first);
+            fill_normal(gen, z.data(), len);
+            this->transform(z.data(), len, out + first, stride);
+        }
+    }
+
+    /**
+     * @brief Number of time steps
+     *
+     * @return size_t
+     */
+    auto dimension() const -> size_t { return this->steps; }
+};
+
+} // namespace lds2
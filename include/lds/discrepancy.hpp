@@ -0,0 +1,236 @@
+#pragma once
+
+#include <algorithm>  // for max, min
+#include <functional> // for function
+#include <ostream>    // for ostream
+#include <stddef.h>   // for size_t
+#include <string>     // for string
+#include <vector>     // for vector
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Kinds of L2 discrepancy
+ *
+ * `L2Star` is the L2 star discrepancy (Warnock's formula), `Centered` and
+ * `WrapAround` are Hickernell's centered and wrap-around L2 discrepancies,
+ * which, unlike `L2Star`, do not depend on which corner of the cube is the
+ * origin. `SphereCap` is the L2 spherical cap discrepancy of points on the
+ * unit sphere S^2 (dim = 3), from Stolarsky's invariance principle:
+ * 4 D^2 = 4/3 - (1/N^2) sum_ij |x_i - x_j|.
+ */
+enum class DiscrepancyKind { L2Star, Centered, WrapAround, SphereCap };
+
+/**
+ * @brief L2 discrepancy of a point set
+ *
+ * The `l2_discrepancy(pts, num, dim, kind)` function returns the L2
+ * discrepancy of the `num` row-major points of [0, 1)^dim in `pts`, from
+ * its closed form: a double sum over all pairs of points of a product over
+ * the coordinates. The pairs are processed in square tiles of a
+ * transposed copy of the points, so the innermost loop runs over the
+ * points of a tile with unit stride, and the tiles of the upper triangle
+ * are shared among threads. Each tile row has its own partial sum, added
+ * up in a fixed order, so the result does not depend on `num_threads`.
+ * The cost is O(num^2 dim); for `L2Star` in 2D, `l2_star_2d()` is used
+ * instead.
+ *
+ * @param[in] pts
+ * @param[in] num
+ * @param[in] dim
+ * @param[in] kind
+ * @param[in] num_threads 0 for all hardware threads
+ * @return double
+ */
+auto l2_discrepancy(const double *pts, size_t num, size_t dim,
+                    DiscrepancyKind kind = DiscrepancyKind::L2Star,
+                    size_t num_threads = 0) -> double;
+
+/**
+ * @brief L2 star discrepancy of a 2D point set in O(num log num)
+ *
+ * The `l2_star_2d(pts, num)` function evaluates Warnock's formula for
+ * `num` row-major points of [0, 1)^2. With the points sorted by x, the
+ * pair sum reduces to prefix counts and prefix sums over the y ranks of
+ * the points seen so far, kept in a Fenwick tree.
+ *
+ * @param[in] pts
+ * @param[in] num
+ * @return double
+ */
+auto l2_star_2d(const double *pts, size_t num) -> double;
+
+/**
+ * @brief Discrepancies of the first `num` points of a sequence
+ */
+struct DiscrepancyRecord {
+    size_t num;
+    size_t dim;
+    double l2_star;
+    double centered;
+    double wrap_around;
+};
+
+/**
+ * @brief Discrepancies of a generator at several sample sizes
+ *
+ * The `measure_discrepancy(gen, sizes)` function generates the first
+ * max(sizes) points of `gen` (any generator with `fill()` and
+ * `dimension()`) once, and evaluates the three L2 discrepancies of each
+ * prefix of `sizes[i]` points.
+ *
+ * @param[in,out] gen
+ * @param[in] sizes
+ * @param[in] num_threads 0 for all hardware threads
+ * @return vector<DiscrepancyRecord>
+ */
+template <typename Gen>
+auto measure_discrepancy(Gen &gen, const vector<size_t> &sizes,
+                         size_t num_threads = 0)
+    -> vector<DiscrepancyRecord> {
+    const auto dim = gen.dimension();
+    auto num = size_t(0);
+    for (const auto &n : sizes) {
+        num = std::max(num, n);
+    }
+    auto pts = vector<double>(num * dim);
+    gen.fill(pts.data(), num);
+    auto res = vector<DiscrepancyRecord>{};
+    for (const auto &n : sizes) {
+        res.push_back({n, dim,
+                       l2_discrepancy(pts.data(), n, dim,
+                                      DiscrepancyKind::L2Star, num_threads),
+                       l2_discrepancy(pts.data(), n, dim,
+                                      DiscrepancyKind::Centered, num_threads),
+                       l2_discrepancy(pts.data(), n, dim,
+                                      DiscrepancyKind::WrapAround,
+                                      num_threads)});
+    }
+    return res;
+}
+
+/**
+ * @brief Write discrepancy records as CSV
+ *
+ * The `write_discrepancy_csv(os, name, records)` function writes one line
+ * `name,n,dim,l2_star,centered,wrap_around` per record, preceded by that
+ * header line when `header` is set, so the records of several generators
+ * can be appended to one file.
+ *
+ * @param[out] os
+ * @param[in] name label of the point set, e.g. "halton(2,3)"
+ * @param[in] records
+ * @param[in] header
+ * @return true on success
+ */
+auto write_discrepancy_csv(std::ostream &os, const std::string &name,
+                           const vector<DiscrepancyRecord> &records,
+                           bool header = true) -> bool;
+
+/**
+ * @brief Online discrepancy monitor
+ *
+ * The `DiscrepancyMonitor` class keeps the L2 discrepancy of a growing
+ * point set up to date as points are added, without rescanning: the closed
+ * forms only need the sum of a per-point term and the sum of a pair kernel
+ * over all pairs, and a new point adds its pairs with the points before it,
+ * O(N dim) work. A batch of new points is processed in parallel. Every
+ * `interval` points the callback receives the number of points and the
+ * current discrepancy; when it returns false, the monitor stops accepting
+ * points, so generation can end as soon as a quality target is met.
+ */
+class DiscrepancyMonitor {
+  public:
+    /** Called as callback(num, discrepancy); false stops the monitor */
+    using Callback = std::function<bool(size_t, double)>;
+
+  private:
+    size_t dim;
+    DiscrepancyKind kind;
+    size_t interval;
+    Callback callback;
+    vector<double> pts; // accepted points, row-major
+    size_t count;       // number of accepted points
+    double single;      // sum of the per-point terms
+    double pairs;       // sum of the pair kernel over all ordered pairs
+    bool stop;
+
+  public:
+    /**
+     * @brief Construct a new DiscrepancyMonitor object
+     *
+     * @param[in] dim
+     * @param[in] kind
+     * @param[in] interval number of points between two callbacks
+     * @param[in] callback may be empty
+     */
+    DiscrepancyMonitor(size_t dim, DiscrepancyKind kind, size_t interval,
+                       Callback callback = nullptr);
+
+    /**
+     * @brief add
+     *
+     * The `add(pts, num)` function adds the `num` row-major points in `pts`,
+     * calling the callback at every multiple of the interval. If the
+     * callback returns false, the remaining points are discarded.
+     *
+     * @param[in] pts
+     * @param[in] num
+     * @param[in] num_threads 0 for all hardware threads
+     * @return size_t number of points accepted
+     */
+    auto add(const double *pts, size_t num, size_t num_threads = 0) -> size_t;
+
+    /**
+     * @brief Current discrepancy
+     *
+     * @return double
+     */
+    auto value() const -> double;
+
+    /**
+     * @brief Number of points accepted
+     *
+     * @return size_t
+     */
+    auto size() const -> size_t { return this->count; }
+
+    /**
+     * @brief Whether the callback has stopped the monitor
+     *
+     * @return bool
+     */
+    auto stopped() const -> bool { return this->stop; }
+};
+
+/**
+ * @brief Generate points until a monitor stops
+ *
+ * The `fill_until(gen, monitor, out, max_num)` function generates points of
+ * `gen` into `out` block by block and feeds them to `monitor`, until the
+ * monitor's callback stops it or `max_num` points have been generated.
+ *
+ * @param[in,out] gen
+ * @param[in,out] monitor
+ * @param[out] out row-major buffer of `max_num * gen.dimension()` doubles
+ * @param[in] max_num
+ * @param[in] block points per block
+ * @param[in] num_threads 0 for all hardware threads
+ * @return size_t number of points accepted by the monitor
+ */
+template <typename Gen>
+auto fill_until(Gen &gen, DiscrepancyMonitor &monitor, double *out,
+                size_t max_num, size_t block = 256, size_t num_threads = 0)
+    -> size_t {
+    const auto dim = gen.dimension();
+    auto num = size_t(0);
+    while (num < max_num && !monitor.stopped()) {
+        const auto len = std::min(block, max_num - num);
+        gen.fill(out + num * dim, len);
+        num += monitor.add(out + num * dim, len, num_threads);
+    }
+    return num;
+}
+
+} // namespace lds2
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <stddef.h> // for size_t
+#include <vector>   // for vector
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Static kd-tree for Euclidean nearest-neighbour queries
+ *
+ * The `KdTree` class holds a reordered copy of a point set in an implicit
+ * balanced kd-tree: every range of points is split at its median along
+ * the axis of largest spread, the median point stays in the middle of the
+ * range, and ranges of at most `LEAF` points are scanned linearly. There
+ * are no node objects, so the tree is the point array itself plus one
+ * axis per split. The top levels are split sequentially and the subtrees
+ * below are built in parallel.
+ */
+class KdTree {
+    size_t dim;
+    vector<double> pts;         // reordered points, row-major
+    vector<size_t> index;       // original index of each reordered point
+    vector<unsigned char> axis; // split axis of the range whose median is i
+
+    auto swap_rows(size_t i, size_t j) -> void;
+    auto split(size_t lo, size_t hi) -> size_t;
+    auto build(size_t lo, size_t hi) -> void;
+    auto search(size_t lo, size_t hi, const double *q, size_t exclude,
+                double &best, size_t &best_i) const -> void;
+
+  public:
+    /** Ranges of at most this many points are not split */
+    static constexpr size_t LEAF = 8;
+
+    /**
+     * @brief Construct a new KdTree object
+     *
+     * @param[in] pts row-major points
+     * @param[in] num
+     * @param[in] dim dimension, at most 255
+     * @param[in] num_threads 0 for all hardware threads
+     */
+    KdTree(const double *pts, size_t num, size_t dim, size_t num_threads = 0);
+
+    /**
+     * @brief nearest
+     *
+     * The `nearest(q, dist2, exclude)` function returns the original index
+     * of the point nearest to `q` and sets `dist2` to its squared distance.
+     * The point of original index `exclude` is skipped, which finds the
+     * nearest neighbour of a point of the set itself.
+     *
+     * @param[in] q
+     * @param[out] dist2
+     * @param[in] exclude original index to skip, or size() for none
+     * @return size_t
+     */
+    auto nearest(const double *q, double &dist2, size_t exclude) const
+        -> size_t;
+
+    /**
+     * @brief nearest
+     *
+     * @param[in] q
+     * @param[out] dist2
+     * @return size_t
+     */
+    auto nearest(const double *q, double &dist2) const -> size_t {
+        return this->nearest(q, dist2, this->size());
+    }
+
+    /**
+     * @brief Minimum pairwise distance of the points of the tree
+     *
+     * @param[in] num_threads 0 for all hardware threads
+     * @return double
+     */
+    auto min_distance(size_t num_threads = 0) const -> double;
+
+    /**
+     * @brief Number of points
+     *
+     * @return size_t
+     */
+    auto size() const -> size_t { return this->index.size(); }
+
+    /**
+     * @brief Number of dimensions
+     *
+     * @return size_t
+     */
+    auto dimension() const -> size_t { return this->dim; }
+};
+
+/**
+ * @brief Minimum pairwise distance
+ *
+ * The `min_distance(pts, num, dim)` function returns the smallest
+ * Euclidean distance between two of the `num` row-major points, the
+ * separation of the set, from one nearest-neighbour query per point in a
+ * `KdTree`, in parallel. It is O(num log num) for well-spread sets.
+ *
+ * @param[in] pts
+ * @param[in] num at least 2
+ * @param[in] dim
+ * @param[in] num_threads 0 for all hardware threads
+ * @return double
+ */
+auto min_distance(const double *pts, size_t num, size_t dim,
+                  size_t num_threads = 0) -> double;
+
+/**
+ * @brief Covering radius (dispersion) estimated on probe points
+ *
+ * The `covering_radius(pts, num, dim, probes, num_probes)` function returns
+ * the largest distance from a probe point to its nearest point of the set,
+ * i.e. the radius of the largest empty ball centered at a probe. With the
+ * probes spread densely over the domain (e.g. 10 to 100 times more points
+ * of another low-discrepancy sequence over the cube, or of `Sphere` over
+ * the sphere, plus the corners for the cube), this is a lower bound of the
+ * covering radius which converges to it as the probes get denser. The
+ * queries run in parallel in a `KdTree` of the set. For points on the unit
+ * sphere the distances are chordal; the geodesic radius is
+ * 2 asin(r / 2).
+ *
+ * @param[in] pts
+ * @param[in] num
+ * @param[in] dim
+ * @param[in] probes row-major probe points
+ * @param[in] num_probes
+ * @param[in] num_threads 0 for all hardware threads
+ * @return double
+ */
+auto covering_radius(const double *pts, size_t num, size_t dim,
+                     const double *probes, size_t num_probes,
+                     size_t num_threads = 0) -> double;
+
+} // namespace lds2
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm> // for fill
+#include <cassert>   // for assert
+#include <cstdint>   // for uint32_t, uint64_t
+#include <stddef.h>  // for size_t
+#include <vector>    // for vector
+
+#include "lds_n.hpp" // for PRIME_TABLE
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Faure sequence generator
+ *
+ * The `Faure` class generates the Faure sequence in `dim` dimensions, using
+ * the single prime base b, the smallest prime in `PRIME_TABLE` with b >= dim.
+ * Coordinate j of point k is the radical inverse of the digit vector
+ * C^j a mod b, where a holds the base-b digits of k and C is the
+ * upper-triangular Pascal matrix, C^j(r, c) = binom(c, r) j^(c - r).
+ *
+ * The entries of all matrix powers are precomputed in one compact table.
+ * Incrementing k changes the digits a_0, ..., a_t (t carries), each by 1
+ * mod b, so only the rows r <= t of every C^j a change: `pop()` costs
+ * O(t^2) per dimension, O(1) on average. Each coordinate is kept as an
+ * exact integer Y = sum_r y_r b^(M-1-r) with b^M < 2^64, so there is no
+ * floating-point drift.
+ */
+class Faure {
+    size_t count;
+    size_t dim;
+    uint32_t base;
+    size_t ndigits;        // M, the number of base-b digits kept
+    vector<uint64_t> pw;   // pw[r] = b^(M-1-r)
+    vector<uint32_t> tab;  // C^j(r, c) at ((c (c+1) / 2 + r) * dim + j)
+    vector<uint32_t> a;    // digits of count
+    vector<uint32_t> y;    // digits of C^j a, at (r * dim + j)
+    vector<uint64_t> ival; // coordinates scaled by b^M
+    vector<uint32_t> tmp;
+    double scale;
+
+    static constexpr auto tri(size_t r, size_t c) -> size_t {
+        return c * (c + 1) / 2 + r;
+    }
+
+    /**
+     * @brief Add the carry to rows 0..t of every C^j a
+     */
+    auto add_carry(size_t t) -> void {
+        const auto d = this->dim;
+        const auto b = this->base;
+        auto *acc = this->tmp.data();
+        auto *iv = this->ival.data();
+        for (size_t r = 0; r <= t; ++r) {
+            auto *yr = &this->y[r * d];
+            for (size_t j = 0; j != d; ++j) {
+                acc[j] = yr[j];
+            }
+            for (auto c = r; c <= t; ++c) {
+                const auto *tc = &this->tab[tri(r, c) * d];
+                for (size_t j = 0; j != d; ++j) {
+                    acc[j] += tc[j];
+                }
+            }
+            const auto p = this->pw[r];
+            for (size_t j = 0; j != d; ++j) {
+                const auto nv = acc[j] % b;
+                iv[j] += (uint64_t(nv) - uint64_t(yr[j])) * p;
+                yr[j] = nv;
+            }
+        }
+    }
+
+    /**
+     * @brief Advance to the next point
+     */
+    auto advance() -> void {
+        this->count += 1;
+        auto t = size_t(0);
+        while (this->a[t] + 1 == this->base) {
+            this->a[t] = 0;
+            ++t;
+            assert(t < this->ndigits);
+        }
+        this->a[t] += 1;
+        this->add_carry(t);
+    }
+
+    auto store(double *out) const -> void {
+        for (size_t j = 0; j != this->dim; ++j) {
+            out[j] = double(this->ival[j]) * this->scale;
+        }
+    }
+
+  public:
+    /**
+     * @brief Construct a new Faure object
+     *
+     * @param[in] dim number of dimensions, 1 <= dim <= 7919
+     */
+    explicit Faure(size_t dim) : count{0}, dim{dim}, base{2}, ndigits{0} {
+        assert(dim >= 1 && dim <= 7919);
+        for (size_t i = 0; PRIME_TABLE[i] < dim; ++i) {
+            this->base = uint32_t(PRIME_TABLE[i + 1]);
+        }
+        const auto b = uint64_t(this->base);
+        auto bm = uint64_t(1);
+        for (; bm <= (UINT64_MAX >> 1U) / b; bm *= b) {
+            ++this->ndigits;
+        }
+        const auto m = this->ndigits;
+        this->scale = 1.0 / double(bm);
+        this->pw.resize(m);
+        for (size_t r = m, p = 1; r-- != 0; p *= b) {
+            this->pw[r] = p;
+        }
+        // binom(c, r) mod b by Pascal's rule, and j^(c - r) mod b
+        auto binom = vector<uint32_t>(m * (m + 1) / 2);
+        for (size_t c = 0; c != m; ++c) {
+            binom[tri(0, c)] = 1;
+            binom[tri(c, c)] = 1;
+            for (size_t r = 1; r < c; ++r) {
+                binom[tri(r, c)] =
+                    (binom[tri(r - 1, c - 1)] + binom[tri(r, c - 1)]) %
+                    this->base;
+            }
+        }
+        this->tab.resize(m * (m + 1) / 2 * dim);
+        for (size_t j = 0; j != dim; ++j) {
+            auto jpow = vector<uint64_t>(m);
+            jpow[0] = 1;
+            for (size_t e = 1; e != m; ++e) {
+                jpow[e] = jpow[e - 1] * (j % b) % b;
+            }
+            for (size_t c = 0; c != m; ++c) {
+                for (size_t r = 0; r <= c; ++r) {
+                    this->tab[tri(r, c) * dim + j] =
+                        uint32_t(binom[tri(r, c)] * jpow[c - r] % b);
+                }
+            }
+        }
+        this->a.assign(m, 0);
+        this->y.assign(m * dim, 0);
+        this->ival.assign(dim, 0);
+        this->tmp.assign(dim, 0);
+    }
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function increments the count and returns the next point
+     * of the Faure sequence as a `std::vector<double>`.
+     *
+     * @return vector<double>
+     */
+    auto pop() -> vector<double> {
+        this->advance();
+        auto res = vector<double>(this->dim);
+        this->store(res.data());
+        return res;
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function generates the next `num`
+     * points and writes them row by row into `out`, which must hold
+     * `num * dim` doubles.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        for (size_t i = 0; i != num; ++i, out += this->dim) {
+            this->advance();
+            this->store(out);
+        }
+    }
+
+    /**
+     * @brief reseed
+     *
+     * The `reseed(size_t seed)` function is used to reset the state of the
+     * sequence generator to a specific point in the sequence, in
+     * O(dim M^2).
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void {
+        this->count = seed;
+        const auto m = this->ndigits;
+        for (size_t c = 0; c != m; ++c, seed /= this->base) {
+            this->a[c] = uint32_t(seed % this->base);
+        }
+        assert(seed == 0);
+        std::fill(this->ival.begin(), this->ival.end(), 0U);
+        for (size_t r = 0; r != m; ++r) {
+            for (size_t j = 0; j != this->dim; ++j) {
+                auto s = uint64_t(0);
+                for (auto c = r; c != m; ++c) {
+                    s += uint64_t(this->tab[tri(r, c) * this->dim + j]) *
+                         this->a[c];
+                }
+                const auto nv = uint32_t(s % this->base);
+                this->y[r * this->dim + j] = nv;
+                this->ival[j] += nv * this->pw[r];
+            }
+        }
+    }
+
+    /**
+     * @brief The prime base of the sequence
+     *
+     * @return size_t
+     */
+    auto get_base() const -> size_t { return this->base; }
+};
+
+} // namespace lds2
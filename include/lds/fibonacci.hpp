@@ -0,0 +1,229 @@
+#pragma once
+
+#include <algorithm> // for max, min
+#include <array>     // for array
+#include <cassert>   // for assert
+#include <cmath>     // for atan2, cos, floor, log, pow, sin, sqrt
+#include <cstdint>   // for uint64_t
+#include <stddef.h>  // for size_t
+#include <vector>    // for vector
+
+#include "lds.hpp"      // for TWO_PI
+#include "parallel.hpp" // for parallel_for
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Spherical Fibonacci point set
+ *
+ * The `SphericalFibonacci` class generates the n points
+ * z_i = 1 - (2 i + 1) / n, phi_i = 2 pi frac(i / Phi), i = 0, ..., n - 1,
+ * on the unit sphere, Phi being the golden ratio. frac(i / Phi) is computed
+ * in 64-bit fixed point, so the azimuth stays exact for any index.
+ *
+ * `nearest()` maps a direction back to the index of the closest point in
+ * O(1), following Keinert et al., "Spherical Fibonacci Mapping": in the
+ * (phi, z) plane the points form a lattice, spanned near latitude z by the
+ * steps F_k and F_{k+1} of two consecutive Fibonacci numbers, where k only
+ * depends on z. Solving for the lattice cell containing the direction
+ * leaves four candidate indices to compare.
+ */
+class SphericalFibonacci {
+    size_t count;
+    size_t n;
+    // per zone k: F_k, F_{k+1} and the inverse of the lattice basis
+    vector<std::array<double, 6>> zones;
+
+    static constexpr uint64_t INV_PHI = 0x9E3779B97F4A7C15U; // 2^64 / Phi
+
+    /**
+     * @brief Point i, written to out[0..2]
+     */
+    auto point(uint64_t i, double *out) const -> void {
+        const auto f = double((i * INV_PHI) >> 11U) / 9007199254740992.0;
+        const auto phi = TWO_PI * f;
+        const auto z = 1.0 - double(2 * i + 1) / double(this->n);
+        const auto s = std::sqrt(std::max(0.0, 1.0 - z * z));
+        out[0] = s * std::cos(phi);
+        out[1] = s * std::sin(phi);
+        out[2] = z;
+    }
+
+  public:
+    /**
+     * @brief Construct a new SphericalFibonacci object
+     *
+     * @param[in] n number of points, n < 2^52
+     */
+    explicit SphericalFibonacci(size_t n) : count{0}, n{n} {
+        assert(n >= 1 && (uint64_t(n) >> 52U) == 0U);
+        const auto gr = (1.0 + std::sqrt(5.0)) / 2.0;
+        const auto zmax = std::log(double(n) * M_PI * std::sqrt(5.0)) /
+                          std::log(gr * gr);
+        const auto kmax = std::max<size_t>(size_t(std::max(zmax, 0.0)), 2);
+        auto f0 = 0.0; // F_k
+        auto f1 = 1.0; // F_{k+1}
+        for (size_t k = 0; k <= kmax; ++k) {
+            if (k >= 1) {
+                const auto f = f0 + f1;
+                f0 = f1;
+                f1 = f;
+            }
+            // phi steps 2 pi (F_k / Phi - F_{k-1}) = 2 pi (-1)^(k+1) Phi^-k
+            auto d0 = TWO_PI * std::pow(gr, -double(k));
+            d0 = k % 2 == 0 ? -d0 : d0;
+            const auto d1 = -d0 / gr;
+            const auto z0 = -2.0 * f0 / double(n);
+            const auto z1 = -2.0 * f1 / double(n);
+            const auto det = d0 * z1 - d1 * z0;
+            this->zones.push_back(
+                {f0, f1, z1 / det, -d1 / det, -z0 / det, d0 / det});
+        }
+    }
+
+    /**
+     * @brief at
+     *
+     * The `at(size_t i)` function returns the i-th point of the set.
+     *
+     * @param[in] i
+     * @return std::array<double, 3>
+     */
+    auto at(size_t i) const -> std::array<double, 3> {
+        auto res = std::array<double, 3>{};
+        this->point(uint64_t(i), res.data());
+        return res;
+    }
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function increments the count and returns the point with
+     * index count mod n.
+     *
+     * @return std::array<double, 3>
+     */
+    auto pop() -> std::array<double, 3> {
+        this->count += 1;
+        return this->at(this->count % this->n);
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out)` function writes all n points row by row into
+     * `out`, which must hold `3 * n` doubles, in parallel.
+     *
+     * @param[out] out
+     * @param[in] num_threads 0 for all hardware threads
+     */
+    auto fill(double *out, size_t num_threads = 0) const -> void {
+        parallel_for(
+            0, this->n,
+            [this, out](size_t first, size_t last) {
+                for (auto i = first; i != last; ++i) {
+                    this->point(uint64_t(i), out + 3 * i);
+                }
+            },
+            num_threads);
+    }
+
+    /**
+     * @brief nearest
+     *
+     * The `nearest(p)` function returns the index of the point closest to
+     * the unit vector `p`, in constant time.
+     *
+     * @param[in] p unit vector
+     * @return size_t
+     */
+    auto nearest(const std::array<double, 3> &p) const -> size_t {
+        return this->nearest(p.data());
+    }
+
+    /**
+     * @brief nearest
+     *
+     * The `nearest(const double *p)` function is `nearest()` for the unit
+     * vector p[0..2].
+     *
+     * @param[in] p
+     * @return size_t
+     */
+    auto nearest(const double *p) const -> size_t {
+        const auto nn = double(this->n);
+        const auto phi = std::atan2(p[1], p[0]);
+        const auto z = p[2];
+        // zone number: F_k is about the spacing of the points at latitude z
+        const auto kz = std::floor(std::log(nn * M_PI * std::sqrt(5.0) *
+                                            (1.0 - z * z)) /
+                                   0.9624236501192069); // log(Phi^2)
+        const auto k =
+            kz >= 2.0 ? std::min(size_t(kz), this->zones.size() - 1) : 2;
+        const auto &zn = this->zones[k];
+        const auto dz = z - (1.0 - 1.0 / nn);
+        const auto c0 = std::floor(zn[2] * phi + zn[3] * dz);
+        const auto c1 = std::floor(zn[4] * phi + zn[5] * dz);
+        auto best = 5.0;
+        auto res = size_t(0);
+        for (auto s = 0U; s != 4U; ++s) {
+            auto i = (c0 + double(s & 1U)) * zn[0];
+            i += (c1 + double(s >> 1U)) * zn[1];
+            i = std::min(std::max(i, 0.0), nn - 1.0);
+            double q[3];
+            this->point(uint64_t(i), q);
+            const auto d = (q[0] - p[0]) * (q[0] - p[0]) +
+                           (q[1] - p[1]) * (q[1] - p[1]) +
+                           (q[2] - p[2]) * (q[2] - p[2]);
+            if (d < best) {
+                best = d;
+                res = size_t(i);
+            }
+        }
+        return res;
+    }
+
+    /**
+     * @brief nearest
+     *
+     * The `nearest(dirs, num, idx)` function maps `num` unit vectors, stored
+     * row by row in `dirs`, to the indices of their nearest points, written
+     * to `idx`, in parallel.
+     *
+     * @param[in] dirs
+     * @param[in] num
+     * @param[out] idx
+     * @param[in] num_threads 0 for all hardware threads
+     */
+    auto nearest(const double *dirs, size_t num, size_t *idx,
+                 size_t num_threads = 0) const -> void {
+        parallel_for(
+            0, num,
+            [this, dirs, idx](size_t first, size_t last) {
+                for (auto i = first; i != last; ++i) {
+                    idx[i] = this->nearest(dirs + 3 * i);
+                }
+            },
+            num_threads);
+    }
+
+    /**
+     * @brief reseed
+     *
+     * The `reseed(size_t seed)` function is used to reset the state of the
+     * sequence generator to a specific point in the set.
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void { this->count = seed; }
+
+    /**
+     * @brief Number of points
+     *
+     * @return size_t
+     */
+    auto size() const -> size_t { return this->n; }
+};
+
+} // namespace lds2
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cassert>  // for assert
+#include <cstdint>  // for uint32_t
+#include <stddef.h> // for size_t
+#include <utility>  // for swap
+#include <vector>   // for vector
+
+#include "scramble.hpp" // for hash32
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Van der Corput sequence with a digit permutation
+ *
+ * The `vdc_perm` function is the Van der Corput sequence value for index `k`
+ * in base `base`, where every digit `d` is replaced by `perm[d]`. The
+ * permutation must fix 0 so that the (infinitely many) leading zero digits
+ * of `k` still contribute nothing.
+ *
+ * @param k
+ * @param base
+ * @param perm permutation of {0, ..., base - 1} with perm[0] == 0
+ * @return double
+ */
+inline auto vdc_perm(size_t k, const size_t base, const uint32_t *perm)
+    -> double {
+    auto vdc = 0.0;
+    auto denom = 1.0;
+    for (; k != 0; k /= base) {
+        const auto remainder = k % base;
+        denom *= double(base);
+        vdc += double(perm[remainder]) / denom;
+    }
+    return vdc;
+}
+
+/**
+ * @brief Faure's deterministic digit permutation
+ *
+ * The `faure_permutation(size_t base)` function returns Faure's permutation
+ * of {0, ..., base - 1}, defined recursively by
+ * sigma_2 = (0, 1); for even b = 2c, sigma_b = (2 sigma_c, 2 sigma_c + 1);
+ * for odd b = 2c + 1, sigma_b is sigma_{2c} with the entries >= c shifted up
+ * by one and c inserted in the middle. The first entry is always 0.
+ *
+ * @param base
+ * @return vector<uint32_t>
+ */
+inline auto faure_permutation(size_t base) -> vector<uint32_t> {
+    if (base <= 2) {
+        auto res = vector<uint32_t>(base);
+        for (size_t j = 0; j != base; ++j) {
+            res[j] = uint32_t(j);
+        }
+        return res;
+    }
+    const auto c = base / 2;
+    auto res = vector<uint32_t>(base);
+    if (base % 2 == 0) {
+        const auto half = faure_permutation(c);
+        for (size_t j = 0; j != c; ++j) {
+            res[j] = 2 * half[j];
+            res[j + c] = 2 * half[j] + 1;
+        }
+    } else {
+        const auto even = faure_permutation(base - 1);
+        const auto shift = [c](uint32_t d) { return d >= c ? d + 1 : d; };
+        for (size_t j = 0; j != c; ++j) {
+            res[j] = shift(even[j]);
+            res[j + c + 1] = shift(even[j + c]);
+        }
+        res[c] = uint32_t(c);
+    }
+    return res;
+}
+
+/**
+ * @brief Random digit permutation fixing 0
+ *
+ * The `random_permutation(size_t base, uint32_t seed)` function returns a
+ * permutation of {0, ..., base - 1} with 0 fixed and the nonzero digits
+ * shuffled by a Fisher-Yates shuffle driven by `hash32`, so the result is
+ * reproducible across platforms.
+ *
+ * @param base
+ * @param seed
+ * @return vector<uint32_t>
+ */
+inline auto random_permutation(size_t base, uint32_t seed) -> vector<uint32_t> {
+    auto res = vector<uint32_t>(base);
+    for (size_t j = 0; j != base; ++j) {
+        res[j] = uint32_t(j);
+    }
+    auto h = hash32(seed);
+    for (auto j = base - 1; j > 1; --j) {
+        h = hash32(h + uint32_t(j));
+        const auto i = 1 + size_t(h) % j; // uniform in [1, j]
+        std::swap(res[i], res[j]);
+    }
+    return res;
+}
+
+/**
+ * @brief Generalized Halton(n) sequence generator with digit permutations
+ *
+ * The `ScrambledHaltonN` class generates the generalized Halton sequence in
+ * which the digits of every dimension are permuted before the radical
+ * inverse is taken. This breaks the strong correlations between dimensions
+ * with large prime bases from `PRIME_TABLE`. The permutations of all
+ * dimensions are built once into a single contiguous table and applied
+ * inside the digit loop by `vdc_perm`, at the cost of one table lookup per
+ * digit. The interface mirrors `HaltonN`.
+ */
+class ScrambledHaltonN {
+  private:
+    size_t count;
+    vector<size_t> bases;
+    vector<size_t> offsets; // start of each dimension's permutation in perms
+    vector<uint32_t> perms; // all permutations, back to back
+
+    template <typename Fn> auto build(Fn &&make_perm) -> void {
+        for (size_t j = 0; j != this->bases.size(); ++j) {
+            assert(this->bases[j] >= 2);
+            this->offsets.emplace_back(this->perms.size());
+            const auto perm = make_perm(j, this->bases[j]);
+            this->perms.insert(this->perms.end(), perm.begin(), perm.end());
+        }
+    }
+
+  public:
+    /**
+     * @brief Construct with Faure's deterministic permutations
+     *
+     * @param[in] base
+     */
+    explicit ScrambledHaltonN(const vector<size_t> &base)
+        : count{0}, bases(base) {
+        this->build([](size_t, size_t b) { return faure_permutation(b); });
+    }
+
+    /**
+     * @brief Construct with random permutations selected by a seed
+     *
+     * Every dimension gets an independent random permutation derived from
+     * `seed` and the dimension index.
+     *
+     * @param[in] base
+     * @param[in] seed
+     */
+    ScrambledHaltonN(const vector<size_t> &base, uint32_t seed)
+        : count{0}, bases(base) {
+        this->build([seed](size_t j, size_t b) {
+            return random_permutation(b, hash32(seed) ^ uint32_t(j));
+        });
+    }
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function increments the count and returns the next point
+     * of the generalized Halton sequence as a `std::vector<double>`.
+     *
+     * @return vector<double>
+     */
+    auto pop() -> vector<double> {
+        auto res = vector<double>(this->bases.size());
+        this->fill(res.data(), 1);
+        return res;
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function generates the next `num`
+     * points and writes them row by row into `out`, which must hold
+     * `num * dim` doubles.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        const auto dim = this->bases.size();
+        for (size_t i = 0; i != num; ++i) {
+            this->count += 1;
+            for (size_t j = 0; j != dim; ++j) {
+                *out++ = vdc_perm(this->count, this->bases[j],
+                                  &this->perms[this->offsets[j]]);
+            }
+        }
+    }
+
+    /**
+     * @brief Number of dimensions
+     *
+     * @return size_t
+     */
+    auto dimension() const -> size_t { return this->bases.size(); }
+
+    /**
+     * @brief reseed
+     *
+     * The `reseed(size_t seed)` function is used to reset the state of the
+     * sequence generator to a specific point in the sequence. The
+     * permutations are kept.
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void { this->count = seed; }
+};
+
+} // namespace lds2
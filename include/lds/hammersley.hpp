@@ -0,0 +1,195 @@
+#pragma once
+
+#include <array>    // for array
+#include <cassert>  // for assert
+#include <cstdint>  // for uint32_t
+#include <stddef.h> // for size_t
+#include <vector>   // for vector
+
+#include "lds.hpp"      // for vdc
+#include "parallel.hpp" // for parallel_for
+#include "scramble.hpp" // for reverse_bits32
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Hammersley point set generator
+ *
+ * The `Hammersley` class generates the fixed-size Hammersley point set
+ * x_k = (k / n, vdc(k, b_1), ..., vdc(k, b_{d-1})), k = 0, ..., n - 1,
+ * whose discrepancy is lower than that of the first n points of the Halton
+ * sequence in the same bases. Points are random access through `at(k)`;
+ * `fill()` builds the whole set in parallel into structure-of-arrays
+ * buffers. `pop()` walks k = 1, ..., n - 1 and then 0, so n calls cover the
+ * set.
+ */
+class Hammersley {
+    size_t count;
+    size_t n;
+    vector<size_t> bases;
+
+  public:
+    /**
+     * @brief Construct a new Hammersley object
+     *
+     * @param[in] n number of points
+     * @param[in] bases bases of the coordinates after the first one
+     */
+    Hammersley(size_t n, const vector<size_t> &bases)
+        : count{0}, n{n}, bases(bases) {
+        assert(n >= 1);
+    }
+
+    /**
+     * @brief at
+     *
+     * The `at(size_t k)` function returns the k-th point of the set, with
+     * `bases.size() + 1` coordinates.
+     *
+     * @param[in] k
+     * @return vector<double>
+     */
+    auto at(size_t k) const -> vector<double> {
+        auto res = vector<double>{double(k) / double(this->n)};
+        for (const auto &b : this->bases) {
+            res.emplace_back(vdc(k, b));
+        }
+        return res;
+    }
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function increments the count and returns the point with
+     * index count mod n.
+     *
+     * @return vector<double>
+     */
+    auto pop() -> vector<double> {
+        this->count += 1;
+        return this->at(this->count % this->n);
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t stride)` function writes all n points in
+     * structure-of-arrays layout: coordinate j of point k goes to
+     * `out[j * stride + k]`, with `stride >= n`. The points are split into
+     * contiguous chunks built on separate threads.
+     *
+     * @param[out] out
+     * @param[in] stride
+     * @param[in] num_threads 0 for all hardware threads
+     */
+    auto fill(double *out, size_t stride, size_t num_threads = 0) const
+        -> void {
+        assert(stride >= this->n);
+        parallel_for(
+            0, this->n,
+            [this, out, stride](size_t first, size_t last) {
+                for (auto k = first; k != last; ++k) {
+                    out[k] = double(k) / double(this->n);
+                }
+                for (size_t j = 0; j != this->bases.size(); ++j) {
+                    auto *col = out + (j + 1) * stride;
+                    for (auto k = first; k != last; ++k) {
+                        col[k] = vdc(k, this->bases[j]);
+                    }
+                }
+            },
+            num_threads);
+    }
+
+    /**
+     * @brief reseed
+     *
+     * The `reseed(size_t seed)` function is used to reset the state of the
+     * sequence generator to a specific point in the set.
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void { this->count = seed; }
+};
+
+/**
+ * @brief Two-dimensional Hammersley point set in base 2
+ *
+ * The `Hammersley2` class is the common case (k / n, vdc(k, 2)), where the
+ * second coordinate is a single 32-bit bit reversal, so the whole set costs
+ * one bit reversal per point.
+ */
+class Hammersley2 {
+    size_t count;
+    size_t n;
+
+  public:
+    /**
+     * @brief Construct a new Hammersley2 object
+     *
+     * @param[in] n number of points, n <= 2^32
+     */
+    explicit Hammersley2(size_t n) : count{0}, n{n} {
+        assert(n >= 1 && (uint64_t(n - 1) >> 32U) == 0U);
+    }
+
+    /**
+     * @brief at
+     *
+     * @param[in] k
+     * @return std::array<double, 2>
+     */
+    auto at(size_t k) const -> std::array<double, 2> {
+        return {double(k) / double(this->n),
+                double(reverse_bits32(uint32_t(k))) / 4294967296.0};
+    }
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function increments the count and returns the point with
+     * index count mod n.
+     *
+     * @return std::array<double, 2>
+     */
+    auto pop() -> std::array<double, 2> {
+        this->count += 1;
+        return this->at(this->count % this->n);
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *x, double *y)` function writes all n points into the
+     * arrays `x` and `y` of length n, in parallel.
+     *
+     * @param[out] x
+     * @param[out] y
+     * @param[in] num_threads 0 for all hardware threads
+     */
+    auto fill(double *x, double *y, size_t num_threads = 0) const -> void {
+        const auto scale = 1.0 / double(this->n);
+        parallel_for(
+            0, this->n,
+            [x, y, scale](size_t first, size_t last) {
+                for (auto k = first; k != last; ++k) {
+                    x[k] = double(k) * scale;
+                    y[k] = double(reverse_bits32(uint32_t(k))) / 4294967296.0;
+                }
+            },
+            num_threads);
+    }
+
+    /**
+     * @brief reseed
+     *
+     * The `reseed(size_t seed)` function is used to reset the state of the
+     * sequence generator to a specific point in the set.
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void { this->count = seed; }
+};
+
+} // namespace lds2
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm> // for min
+#include <array>     // for array
+#include <cassert>   // for assert
+#include <stddef.h>  // for size_t
+#include <vector>    // for vector
+
+#include "parallel.hpp" // for parallel_for
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Hierarchical sample warping for a tabulated 2D density
+ *
+ * The `Hierarchical2D` class warps uniform points of [0, 1)^2 so that they
+ * follow a piecewise-constant density given on a width x height grid.
+ * The density is padded with zeros to a 2^k x 2^k grid and summed into a
+ * mip pyramid, each level stored in Morton order so that the four
+ * children of a node are adjacent in memory. A point is pushed down the
+ * pyramid: at every level u picks the left or right column of the 2 x 2
+ * children in proportion to their sums, v picks the row within that
+ * column, and both are rescaled to [0, 1) for the next level. There is no
+ * search, each level is a few flops, and the top levels stay in cache. The
+ * warp is continuous and monotone within every node, so the
+ * stratification of the input points (e.g. from `Halton`) is preserved.
+ */
+class Hierarchical2D {
+    size_t width;
+    size_t height;
+    size_t levels;              // grid is 2^levels x 2^levels
+    vector<vector<double>> mip; // mip[l] has 4^l sums in Morton order
+    double total;
+
+    // largest double below 1, keeps rescaled coordinates in [0, 1)
+    static constexpr double ONE_BELOW = 1.0 - 1.0 / 9007199254740992.0;
+
+    static auto morton(size_t x, size_t y) -> size_t {
+        auto m = size_t(0);
+        for (size_t b = 0; (x >> b) != 0U || (y >> b) != 0U; ++b) {
+            m |= ((x >> b) & 1U) << (2 * b);
+            m |= ((y >> b) & 1U) << (2 * b + 1);
+        }
+        return m;
+    }
+
+  public:
+    /**
+     * @brief Construct a new Hierarchical2D object
+     *
+     * @param[in] density nonnegative values, row-major, density[y * width + x]
+     * @param[in] width
+     * @param[in] height
+     */
+    Hierarchical2D(const vector<double> &density, size_t width, size_t height)
+        : width{width}, height{height}, levels{0}, total{0.0} {
+        assert(density.size() == width * height);
+        while ((size_t(1) << this->levels) < width ||
+               (size_t(1) << this->levels) < height) {
+            ++this->levels;
+        }
+        const auto k = this->levels;
+        this->mip.resize(k + 1);
+        this->mip[k].assign(size_t(1) << (2 * k), 0.0);
+        for (size_t y = 0; y != height; ++y) {
+            for (size_t x = 0; x != width; ++x) {
+                assert(density[y * width + x] >= 0.0);
+                this->mip[k][morton(x, y)] = density[y * width + x];
+            }
+        }
+        for (auto l = k; l-- != 0;) {
+            const auto &fine = this->mip[l + 1];
+            auto &coarse = this->mip[l];
+            coarse.resize(size_t(1) << (2 * l));
+            for (size_t m = 0; m != coarse.size(); ++m) {
+                coarse[m] = fine[4 * m] + fine[4 * m + 1] + fine[4 * m + 2] +
+                            fine[4 * m + 3];
+            }
+        }
+        this->total = this->mip[0][0];
+        assert(this->total > 0.0);
+    }
+
+    /**
+     * @brief warp
+     *
+     * The `warp(u, v)` function maps the uniform point (u, v) to a point of
+     * [0, 1)^2 distributed according to the density.
+     *
+     * @param[in] u
+     * @param[in] v
+     * @return std::array<double, 2>
+     */
+    auto warp(double u, double v) const -> std::array<double, 2> {
+        auto node = size_t(0);
+        auto x = size_t(0);
+        auto y = size_t(0);
+        for (size_t l = 1; l <= this->levels; ++l) {
+            // children: 0 = (x0, y0), 1 = (x1, y0), 2 = (x0, y1), 3 = (x1, y1)
+            const auto *c = &this->mip[l][4 * node];
+            const auto left = c[0] + c[2];
+            const auto pl = left / (left + c[1] + c[3]);
+            auto bx = size_t(0);
+            if (u < pl) {
+                u = std::min(u / pl, ONE_BELOW);
+            } else {
+                u = std::min((u - pl) / (1.0 - pl), ONE_BELOW);
+                bx = 1;
+            }
+            const auto pt = c[bx] / (c[bx] + c[bx + 2]);
+            auto by = size_t(0);
+            if (v < pt) {
+                v = std::min(v / pt, ONE_BELOW);
+            } else {
+                v = std::min((v - pt) / (1.0 - pt), ONE_BELOW);
+                by = 2;
+            }
+            node = 4 * node + bx + by;
+            x = 2 * x + bx;
+            y = 2 * y + by / 2;
+        }
+        return {(double(x) + u) / double(this->width),
+                (double(y) + v) / double(this->height)};
+    }
+
+    /**
+     * @brief warp
+     *
+     * The `warp(double *pts, size_t num)` function warps `num` row-major
+     * points (u, v) in place, in parallel.
+     *
+     * @param[in,out] pts
+     * @param[in] num
+     * @param[in] num_threads 0 for all hardware threads
+     */
+    auto warp(double *pts, size_t num, size_t num_threads = 0) const
+        -> void {
+        parallel_for(
+            0, num,
+            [this, pts](size_t first, size_t last) {
+                for (auto k = first; k != last; ++k) {
+                    const auto p = this->warp(pts[2 * k], pts[2 * k + 1]);
+                    pts[2 * k] = p[0];
+                    pts[2 * k + 1] = p[1];
+                }
+            },
+            num_threads);
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(gen, out, num)` function draws the next `num` points of the
+     * 2D generator `gen` (e.g. `Halton(2, 3)`) into `out`, which must hold
+     * `2 * num` doubles, and warps them in place with `warp()`.
+     *
+     * @param[in,out] gen
+     * @param[out] out
+     * @param[in] num
+     * @param[in] num_threads 0 for all hardware threads
+     */
+    template <typename Gen>
+    auto fill(Gen &gen, double *out, size_t num, size_t num_threads = 0) const
+        -> void {
+        assert(gen.dimension() == 2);
+        gen.fill(out, num);
+        this->warp(out, num, num_threads);
+    }
+
+    /**
+     * @brief Probability density at a point
+     *
+     * The `pdf(x, y)` function returns the density at (x, y) in [0, 1)^2,
+     * normalized to integrate to 1.
+     *
+     * @param[in] x
+     * @param[in] y
+     * @return double
+     */
+    auto pdf(double x, double y) const -> double {
+        auto i = size_t(x * double(this->width));
+        auto j = size_t(y * double(this->height));
+        i = i < this->width ? i : this->width - 1;
+        j = j < this->height ? j : this->height - 1;
+        return this->mip[this->levels][morton(i, j)] *
+               double(this->width * this->height) / this->total;
+    }
+};
+
+} // namespace lds2
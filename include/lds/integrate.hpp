@@ -0,0 +1,400 @@
+#pragma once
+
+#include <algorithm> // for max, min, partial_sort
+#include <cassert>   // for assert
+#include <cmath>     // for abs, sqrt
+#include <cstdint>   // for uint32_t
+#include <stddef.h>  // for size_t
+#include <vector>    // for vector
+
+#include "lds.hpp"      // for vdc
+#include "lds_n.hpp"    // for PRIME_TABLE
+#include "parallel.hpp" // for parallel_for
+#include "scramble.hpp" // for hash32
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Compensated (Kahan-Babuska-Neumaier) summation
+ */
+class CompensatedSum {
+    double sum = 0.0;
+    double comp = 0.0;
+
+  public:
+    /**
+     * @brief Add a term
+     *
+     * @param[in] x
+     */
+    auto add(double x) -> void {
+        const auto t = this->sum + x;
+        this->comp += std::abs(this->sum) >= std::abs(x)
+                          ? (this->sum - t) + x
+                          : (x - t) + this->sum;
+        this->sum = t;
+    }
+
+    /**
+     * @brief The compensated sum
+     *
+     * @return double
+     */
+    auto value() const -> double { return this->sum + this->comp; }
+};
+
+/**
+ * @brief Options of `integrate()`
+ */
+struct IntegrateOptions {
+    size_t replicates = 16; // independent random shifts, >= 2
+    double abs_tol = 0.0;   // stop once the standard error is below
+    double rel_tol = 0.0;   // max(abs_tol, rel_tol * |value|)
+    size_t num_threads = 0; // 0 for all hardware threads
+    uint32_t seed = 0;      // seed of the random shifts
+};
+
+/**
+ * @brief Result of `integrate()`
+ */
+struct IntegrateResult {
+    double value;       // mean of the replicate estimates
+    double std_error;   // standard error of the mean over the replicates
+    size_t num_points;  // points per replicate
+    size_t evaluations; // total number of function evaluations
+    bool converged;     // whether the tolerance was met
+};
+
+/**
+ * @brief Randomized quasi-Monte Carlo integration over [0, 1)^dim
+ *
+ * The `integrate(f, dim, n, options)` function estimates the integral of
+ * `f` over the unit cube with `options.replicates` independent random
+ * shifts (Cranley-Patterson, modulo 1) of the first `n` Halton points with
+ * the first `dim` primes as bases. The spread of the replicate means gives
+ * the standard error.
+ *
+ * `f` is evaluated on blocks of `BLOCK` points in structure-of-arrays
+ * layout: `f(x, stride, num, y)` must set y[i] to the value at the point
+ * whose coordinate k is x[k * stride + i], for i < num. Points are
+ * generated directly from their index with `vdc()`, so the blocks of all
+ * replicates are independent tasks shared among threads. Each block has
+ * its own partial sum, and the partials are added with compensated
+ * summation in a fixed order, so the result does not depend on the number
+ * of threads. Blocks run concurrently, so `f` must be safe to call from
+ * several threads at once; set `options.num_threads = 1` for a stateful
+ * integrand.
+ *
+ * When a tolerance is given, the points are processed in stages of
+ * doubling size, 1024, 2048, ..., up to `n`, and integration stops after
+ * the first stage whose standard error meets the tolerance.
+ *
+ * @param[in] f batched integrand, see above, called concurrently from
+ *             `options.num_threads` threads
+ * @param[in] dim dimension, at most 1000
+ * @param[in] n maximal number of points per replicate
+ * @param[in] options
+ * @return IntegrateResult
+ */
+template <typename Fn>
+auto integrate(Fn &&f, size_t dim, size_t n,
+               const IntegrateOptions &options = IntegrateOptions{})
+    -> IntegrateResult {
+    constexpr size_t BLOCK = 256;
+    const auto reps = options.replicates;
+    assert(reps >= 2 && dim >= 1 && dim <= 1000 && n >= 1);
+
+    auto shift = vector<double>(reps * dim);
+    const auto seed = hash32(options.seed);
+    for (size_t r = 0; r != reps; ++r) {
+        for (size_t k = 0; k != dim; ++k) {
+            const auto h = hash32(hash32(seed + uint32_t(r)) + uint32_t(k));
+            shift[r * dim + k] = double(h) / 4294967296.0;
+        }
+    }
+
+    auto sums = vector<CompensatedSum>(reps);
+    auto res = IntegrateResult{0.0, 0.0, 0, 0, false};
+    const auto tol = options.abs_tol > 0.0 || options.rel_tol > 0.0;
+    auto done = size_t(0);
+    while (done < n) {
+        const auto end = tol ? std::min(n, std::max<size_t>(1024, 2 * done))
+                             : n;
+        const auto blocks = (end - done + BLOCK - 1) / BLOCK;
+        auto partial = vector<double>(reps * blocks);
+        parallel_for(
+            0, reps * blocks,
+            [&](size_t first, size_t last) {
+                auto x = vector<double>(dim * BLOCK);
+                double y[BLOCK];
+                for (auto t = first; t != last; ++t) {
+                    const auto r = t / blocks;
+                    const auto i0 = done + (t % blocks) * BLOCK;
+                    const auto len = std::min(BLOCK, end - i0);
+                    for (size_t k = 0; k != dim; ++k) {
+                        const auto s = shift[r * dim + k];
+                        for (size_t i = 0; i != len; ++i) {
+                            // Halton points start at index 1, as in HaltonN
+                            const auto u = vdc(i0 + i + 1, PRIME_TABLE[k]) + s;
+                            x[k * BLOCK + i] = u < 1.0 ? u : u - 1.0;
+                        }
+                    }
+                    f(x.data(), BLOCK, len, y);
+                    auto acc = CompensatedSum{};
+                    for (size_t i = 0; i != len; ++i) {
+                        acc.add(y[i]);
+                    }
+                    partial[t] = acc.value();
+                }
+            },
+            options.num_threads, 1);
+        for (size_t r = 0; r != reps; ++r) {
+            for (size_t b = 0; b != blocks; ++b) {
+                sums[r].add(partial[r * blocks + b]);
+            }
+        }
+        done = end;
+
+        auto mean = CompensatedSum{};
+        for (const auto &s : sums) {
+            mean.add(s.value() / double(done));
+        }
+        res.value = mean.value() / double(reps);
+        auto var = CompensatedSum{};
+        for (const auto &s : sums) {
+            const auto d = s.value() / double(done) - res.value;
+            var.add(d * d);
+        }
+        res.std_error = std::sqrt(var.value() / double(reps * (reps - 1)));
+        res.num_points = done;
+        res.evaluations = done * reps;
+        res.converged =
+            tol && res.std_error <= std::max(options.abs_tol,
+                                             options.rel_tol *
+                                                 std::abs(res.value));
+        if (res.converged) {
+            break;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Options of `integrate_adaptive()`
+ */
+struct AdaptiveOptions {
+    size_t points_per_box = 1024;       // points per replicate in a box
+    size_t replicates = 8;              // random shifts per box, >= 2
+    size_t boxes_per_round = 8;         // boxes split per round, >= 1
+    size_t max_evaluations = 100000000; // evaluation budget, >= one box
+    double abs_tol = 0.0;               // stop once the standard error is
+    double rel_tol = 0.0;               // below max(abs_tol, rel_tol * |value|)
+    size_t num_threads = 0;             // 0 for all hardware threads
+    uint32_t seed = 0;                  // seed of the random shifts
+};
+
+/**
+ * @brief Result of `integrate_adaptive()`
+ */
+struct AdaptiveResult {
+    double value;       // sum of the box estimates
+    double std_error;   // combined standard error of the boxes
+    size_t num_boxes;   // number of boxes in the final partition
+    size_t evaluations; // total number of function evaluations
+    bool converged;     // whether the tolerance was met
+};
+
+/**
+ * @brief Adaptive randomized quasi-Monte Carlo integration over [0, 1)^dim
+ *
+ * The `integrate_adaptive(f, dim, options)` function partitions the unit
+ * cube into boxes and integrates each box with `integrate()`, the Halton
+ * points being mapped affinely into the box and each box having its own
+ * random shifts, so the box errors are independent. Every round, the
+ * `boxes_per_round` boxes with the largest standard errors are split in
+ * half, and the children are integrated afresh, in parallel. Points thus
+ * concentrate where the integrand varies, e.g. around the peak of a
+ * likelihood.
+ *
+ * The split axis follows MISER: the one along which stratifying the box
+ * reduces the spread of `f` the most, i.e. with the smallest sum of the
+ * standard deviations of `f` over the strata, measured from the points
+ * already evaluated in the box. The strata are the quarters of the box
+ * along the axis rather than its halves, since for a feature centred in
+ * the box, the halves of every axis have the same spread and the choice
+ * would be left to noise.
+ *
+ * The box estimates steer the refinement, so the boxes kept unsplit are
+ * biased towards those whose replicates happen to have a small spread,
+ * which for a peaked integrand means an estimate too low. Once the
+ * tolerance is met, or the budget allows no further round, every box of
+ * the final partition is therefore integrated again with fresh shifts,
+ * and `value` and `std_error` come from these unbiased estimates only. If
+ * they miss the tolerance and the budget allows, refinement goes on.
+ *
+ * `f` has the signature of the integrand of `integrate()` and is called
+ * concurrently from `options.num_threads` threads. The partition and the
+ * result do not depend on the number of threads. `max_evaluations`
+ * includes the final re-estimation, and must allow at least the first box,
+ * `points_per_box * replicates` evaluations.
+ *
+ * @param[in] f batched integrand, as for `integrate()`
+ * @param[in] dim dimension, at most 1000
+ * @param[in] options
+ * @return AdaptiveResult
+ */
+template <typename Fn>
+auto integrate_adaptive(Fn &&f, size_t dim,
+                        const AdaptiveOptions &options = AdaptiveOptions{})
+    -> AdaptiveResult {
+    constexpr size_t BINS = 4; // strata per axis for the split rule
+
+    struct Box {
+        vector<double> lo;
+        vector<double> hi;
+        double value;
+        double error;
+        size_t axis; // preferred split axis
+        uint32_t id; // selects the random shifts
+    };
+
+    auto opts = IntegrateOptions{};
+    opts.replicates = options.replicates;
+    opts.num_threads = 1; // the boxes are the parallel tasks
+    const auto per_box = options.points_per_box * options.replicates;
+    assert(options.boxes_per_round >= 1);
+    assert(options.max_evaluations >= per_box);
+
+    auto evaluate = [&](Box &b) {
+        auto vol = 1.0;
+        for (size_t k = 0; k != dim; ++k) {
+            vol *= b.hi[k] - b.lo[k];
+        }
+        auto x = vector<double>{};
+        // count, sum and sum of squares of f over each stratum of each axis
+        auto cnt = vector<double>(dim * BINS, 0.0);
+        auto sum = vector<double>(dim * BINS, 0.0);
+        auto sum2 = vector<double>(dim * BINS, 0.0);
+        auto g = [&](const double *u, size_t stride, size_t num, double *y) {
+            x.resize(dim * stride);
+            for (size_t k = 0; k != dim; ++k) {
+                const auto w = b.hi[k] - b.lo[k];
+                for (size_t i = 0; i != num; ++i) {
+                    x[k * stride + i] = b.lo[k] + w * u[k * stride + i];
+                }
+            }
+            f(x.data(), stride, num, y);
+            for (size_t k = 0; k != dim; ++k) {
+                for (size_t i = 0; i != num; ++i) {
+                    const auto q = std::min(
+                        BINS - 1, size_t(u[k * stride + i] * double(BINS)));
+                    cnt[k * BINS + q] += 1.0;
+                    sum[k * BINS + q] += y[i];
+                    sum2[k * BINS + q] += y[i] * y[i];
+                }
+            }
+        };
+        auto o = opts;
+        o.seed = hash32(options.seed) ^ hash32(b.id);
+        const auto r = integrate(g, dim, options.points_per_box, o);
+        b.value = vol * r.value;
+        b.error = vol * r.std_error;
+        auto best = 0.0;
+        for (size_t k = 0; k != dim; ++k) {
+            auto spread = 0.0;
+            for (auto q = k * BINS; q != (k + 1) * BINS; ++q) {
+                if (cnt[q] > 0.0) {
+                    const auto mean = sum[q] / cnt[q];
+                    const auto var = sum2[q] / cnt[q] - mean * mean;
+                    spread += std::sqrt(std::max(var, 0.0));
+                }
+            }
+            if (k == 0 || spread < best) {
+                best = spread;
+                b.axis = k;
+            }
+        }
+    };
+
+    // integrate a list of boxes in parallel, with new random shifts
+    auto next_id = uint32_t(0);
+    auto res = AdaptiveResult{0.0, 0.0, 0, 0, false};
+    auto evaluate_all = [&](vector<Box> &list) {
+        for (auto &b : list) {
+            b.id = next_id++;
+        }
+        parallel_for(
+            0, list.size(),
+            [&](size_t first, size_t last) {
+                for (auto i = first; i != last; ++i) {
+                    evaluate(list[i]);
+                }
+            },
+            options.num_threads, 1);
+        res.evaluations += list.size() * per_box;
+    };
+
+    auto boxes = vector<Box>{};
+    boxes.push_back({vector<double>(dim, 0.0), vector<double>(dim, 1.0), 0.0,
+                     0.0, 0, 0});
+    evaluate_all(boxes);
+    auto fresh = true; // whether the estimates have not steered any split
+    const auto tol = options.abs_tol > 0.0 || options.rel_tol > 0.0;
+    while (true) {
+        auto value = CompensatedSum{};
+        auto var = CompensatedSum{};
+        for (const auto &b : boxes) {
+            value.add(b.value);
+            var.add(b.error * b.error);
+        }
+        res.value = value.value();
+        res.std_error = std::sqrt(var.value());
+        res.num_boxes = boxes.size();
+        const auto met =
+            tol && res.std_error <= std::max(options.abs_tol,
+                                             options.rel_tol *
+                                                 std::abs(res.value));
+        res.converged = met && fresh;
+        if (res.converged) {
+            break;
+        }
+        // a round splits num boxes and leaves room for the re-estimation
+        const auto num = std::min(options.boxes_per_round, boxes.size());
+        const auto can_split = res.evaluations + (2 * num + boxes.size() +
+                                                  num) * per_box <=
+                               options.max_evaluations;
+        if (met || !can_split) {
+            if (fresh || res.evaluations + boxes.size() * per_box >
+                             options.max_evaluations) {
+                break;
+            }
+            evaluate_all(boxes);
+            fresh = true;
+            continue;
+        }
+
+        // split the boxes with the largest errors (ties by creation order)
+        std::partial_sort(boxes.begin(), boxes.begin() + std::ptrdiff_t(num),
+                          boxes.end(), [](const Box &a, const Box &b) {
+                              return a.error != b.error ? a.error > b.error
+                                                        : a.id < b.id;
+                          });
+        auto children = vector<Box>{};
+        for (size_t i = 0; i != num; ++i) {
+            const auto &b = boxes[i];
+            const auto mid = 0.5 * (b.lo[b.axis] + b.hi[b.axis]);
+            children.push_back(b);
+            children.back().hi[b.axis] = mid;
+            children.push_back(b);
+            children.back().lo[b.axis] = mid;
+        }
+        evaluate_all(children);
+        boxes.erase(boxes.begin(), boxes.begin() + std::ptrdiff_t(num));
+        boxes.insert(boxes.end(), children.begin(), children.end());
+        fresh = false;
+    }
+    return res;
+}
+
+} // namespace lds2
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cmath>    // for pow, floor
+#include <cstdint>  // for uint64_t
+#include <stddef.h> // for size_t
+#include <vector>   // for vector
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Generalized golden ratio
+ *
+ * The `golden_ratio(size_t dim)` function returns the unique positive root
+ * phi_d of x^(d+1) = x + 1, i.e. the golden ratio for d = 1 and the plastic
+ * number for d = 2. It is found by the fixed-point iteration
+ * x <- (1 + x)^(1 / (d + 1)), which converges quickly from x = 2.
+ *
+ * @param dim
+ * @return double
+ */
+inline auto golden_ratio(size_t dim) -> double {
+    auto x = 2.0;
+    const auto e = 1.0 / double(dim + 1);
+    for (auto i = 0; i != 64; ++i) {
+        x = std::pow(1.0 + x, e);
+    }
+    return x;
+}
+
+/**
+ * @brief Additive recurrence (Kronecker) sequence generator
+ *
+ * The `Kronecker` class generates the additive recurrence
+ * x_k = frac(k * alpha) for a vector of irrational steps `alpha`. The state is
+ * kept as 64-bit fixed-point fractions, so frac() is plain unsigned
+ * wrap-around and x_{k+1} = x_k + alpha is exact: no rounding error
+ * accumulates however long the sequence runs, and `at(k)` (one multiply per
+ * coordinate) agrees bit for bit with the k-th `pop()`.
+ */
+class Kronecker {
+    vector<uint64_t> alpha; // steps as 0.64 fixed point
+    vector<uint64_t> state; // current point as 0.64 fixed point
+
+    static constexpr double SCALE = 1.0 / 9007199254740992.0; // 2^-53
+
+    /**
+     * @brief Convert a 0.64 fixed-point fraction to a double in [0, 1)
+     *
+     * Only the top 53 bits are kept, so that values close to 1 cannot round
+     * up to 1.0.
+     */
+    static auto to_double(uint64_t x) -> double {
+        return double(x >> 11U) * SCALE;
+    }
+
+  public:
+    /**
+     * @brief Construct a new Kronecker object
+     *
+     * @param[in] alpha steps in [0, 1), one per dimension
+     */
+    explicit Kronecker(const vector<double> &alpha)
+        : state(alpha.size(), 0U) {
+        for (const auto &a : alpha) {
+            this->alpha.emplace_back(uint64_t(a * 18446744073709551616.0));
+        }
+    }
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function adds `alpha` to the state and returns the next
+     * point of the sequence as a `std::vector<double>`.
+     *
+     * @return vector<double>
+     */
+    auto pop() -> vector<double> {
+        auto res = vector<double>(this->state.size());
+        this->fill(res.data(), 1);
+        return res;
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function generates the next `num`
+     * points and writes them row by row into `out`, which must hold
+     * `num * dim` doubles. Each coordinate costs one integer add and one
+     * conversion, in a contiguous loop the compiler can vectorize.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        const auto dim = this->state.size();
+        const auto *a = this->alpha.data();
+        auto *x = this->state.data();
+        for (size_t i = 0; i != num; ++i, out += dim) {
+            for (size_t j = 0; j != dim; ++j) {
+                x[j] += a[j];
+                out[j] = to_double(x[j]);
+            }
+        }
+    }
+
+    /**
+     * @brief at
+     *
+     * The `at(size_t k)` function returns the k-th point of the sequence
+     * without touching the generator state.
+     *
+     * @param[in] k
+     * @return vector<double>
+     */
+    auto at(size_t k) const -> vector<double> {
+        auto res = vector<double>(this->alpha.size());
+        for (size_t j = 0; j != this->alpha.size(); ++j) {
+            res[j] = to_double(uint64_t(k) * this->alpha[j]);
+        }
+        return res;
+    }
+
+    /**
+     * @brief reseed
+     *
+     * The `reseed(size_t seed)` function is used to reset the state of the
+     * sequence generator to a specific point in the sequence, in O(dim).
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void {
+        for (size_t j = 0; j != this->alpha.size(); ++j) {
+            this->state[j] = uint64_t(seed) * this->alpha[j];
+        }
+    }
+
+    /**
+     * @brief Number of dimensions
+     *
+     * @return size_t
+     */
+    auto dimension() const -> size_t { return this->alpha.size(); }
+};
+
+/**
+ * @brief Steps of the R_d sequence
+ *
+ * The `rd_alpha(size_t dim)` function returns alpha_j = frac(1 / phi_d^(j+1))
+ * for j = 0, ..., dim - 1, where phi_d is `golden_ratio(dim)` (Roberts' R_d
+ * sequence).
+ *
+ * @param dim
+ * @return vector<double>
+ */
+inline auto rd_alpha(size_t dim) -> vector<double> {
+    const auto g = golden_ratio(dim);
+    auto res = vector<double>{};
+    auto a = 1.0;
+    for (size_t j = 0; j != dim; ++j) {
+        a /= g;
+        res.emplace_back(a - std::floor(a));
+    }
+    return res;
+}
+
+/**
+ * @brief R_d sequence generator
+ *
+ * The `RdSequence` class is the `Kronecker` sequence with the steps of
+ * `rd_alpha(dim)`, a good default for any number of dimensions.
+ */
+class RdSequence : public Kronecker {
+  public:
+    /**
+     * @brief Construct a new RdSequence object
+     *
+     * @param[in] dim
+     */
+    explicit RdSequence(size_t dim) : Kronecker(rd_alpha(dim)) {}
+};
+
+} // namespace lds2
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <cassert>  // for assert
+#include <cstdint>  // for uint32_t, uint64_t
+#include <stddef.h> // for size_t
+#include <string>   // for string
+#include <vector>   // for vector
+
+#include "scramble.hpp" // for reverse_bits32
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Rank-1 lattice point set
+ *
+ * The `Lattice` class generates the n points x_k = frac(k * z / n),
+ * k = 0, ..., n - 1, of a rank-1 lattice rule with generating vector `z`.
+ * Like the other generators, `pop()` starts at k = 1; the point k = 0 is the
+ * origin. Each new point is one add and one compare per coordinate, and
+ * `at(k)` is one multiply-mod per coordinate.
+ */
+class Lattice {
+    uint64_t n;
+    vector<uint64_t> z;
+    vector<uint64_t> state; // k * z mod n
+
+  public:
+    /**
+     * @brief Construct a new Lattice object
+     *
+     * @param[in] z generating vector, one entry per dimension
+     * @param[in] n number of points, n < 2^32
+     */
+    Lattice(const vector<size_t> &z, size_t n)
+        : n{n}, z(z.begin(), z.end()), state(z.size(), 0U) {
+        assert(n >= 1 && (uint64_t(n) >> 32U) == 0U);
+        for (auto &zj : this->z) {
+            zj %= this->n;
+        }
+    }
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function adds `z` to the state modulo n and returns the
+     * next lattice point as a `std::vector<double>`.
+     *
+     * @return vector<double>
+     */
+    auto pop() -> vector<double> {
+        auto res = vector<double>(this->z.size());
+        this->fill(res.data(), 1);
+        return res;
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function generates the next `num`
+     * points and writes them row by row into `out`, which must hold
+     * `num * dim` doubles.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        const auto dim = this->z.size();
+        const auto scale = 1.0 / double(this->n);
+        for (size_t i = 0; i != num; ++i, out += dim) {
+            for (size_t j = 0; j != dim; ++j) {
+                auto x = this->state[j] + this->z[j];
+                x = x >= this->n ? x - this->n : x;
+                this->state[j] = x;
+                out[j] = double(x) * scale;
+            }
+        }
+    }
+
+    /**
+     * @brief at
+     *
+     * The `at(size_t k)` function returns the k-th lattice point without
+     * touching the generator state.
+     *
+     * @param[in] k
+     * @return vector<double>
+     */
+    auto at(size_t k) const -> vector<double> {
+        const auto kk = uint64_t(k) % this->n;
+        auto res = vector<double>(this->z.size());
+        for (size_t j = 0; j != this->z.size(); ++j) {
+            res[j] = double(kk * this->z[j] % this->n) / double(this->n);
+        }
+        return res;
+    }
+
+    /**
+     * @brief reseed
+     *
+     * The `reseed(size_t seed)` function is used to reset the state of the
+     * sequence generator to a specific point in the sequence.
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void {
+        const auto kk = uint64_t(seed) % this->n;
+        for (size_t j = 0; j != this->z.size(); ++j) {
+            this->state[j] = kk * this->z[j] % this->n;
+        }
+    }
+};
+
+/**
+ * @brief Embedded (extensible) rank-1 lattice sequence in base 2
+ *
+ * The `LatticeSeq` class generates x_k = frac(phi_2(k) * z), where phi_2 is
+ * the Van der Corput radical inverse in base 2. For every m, the first 2^m
+ * points form the rank-1 lattice with 2^m points and generating vector
+ * z mod 2^m, so a generating vector from `cbc_embedded()` gives good
+ * lattices at every power of two up to its design size. With phi_2(k) as a
+ * 0.32 fixed-point number the product is a wrapping 32-bit multiply.
+ */
+class LatticeSeq {
+    size_t count;
+    vector<uint32_t> z;
+
+  public:
+    /**
+     * @brief Construct a new LatticeSeq object
+     *
+     * @param[in] z odd generating vector entries
+     */
+    explicit LatticeSeq(const vector<size_t> &z) : count{0} {
+        for (const auto &zj : z) {
+            this->z.emplace_back(uint32_t(zj));
+        }
+    }
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function increments the count and returns the next point
+     * as a `std::vector<double>`.
+     *
+     * @return vector<double>
+     */
+    auto pop() -> vector<double> {
+        auto res = vector<double>(this->z.size());
+        this->fill(res.data(), 1);
+        return res;
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function generates the next `num`
+     * points and writes them row by row into `out`, which must hold
+     * `num * dim` doubles: one bit reversal per point and one multiply per
+     * coordinate.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        const auto dim = this->z.size();
+        for (size_t i = 0; i != num; ++i, out += dim) {
+            this->count += 1;
+            const auto r = reverse_bits32(uint32_t(this->count));
+            for (size_t j = 0; j != dim; ++j) {
+                out[j] = double(uint32_t(r * this->z[j])) / 4294967296.0;
+            }
+        }
+    }
+
+    /**
+     * @brief reseed
+     *
+     * The `reseed(size_t seed)` function is used to reset the state of the
+     * sequence generator to a specific point in the sequence.
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void { this->count = seed; }
+};
+
+/**
+ * @brief Fast component-by-component construction for prime n
+ *
+ * The `cbc_prime(n, gamma)` function constructs a generating vector for a
+ * rank-1 lattice rule with a prime number `n` of points, minimizing the
+ * worst-case error in the weighted Korobov space of smoothness 2 with
+ * product weights `gamma` (one per dimension). Following Nuyens and Cools,
+ * the search over all candidates of one component is a circulant
+ * matrix-vector product, evaluated by FFT in O(n log n).
+ *
+ * @param[in] n prime number of points, n < 2^32
+ * @param[in] gamma product weights
+ * @return vector<size_t> generating vector
+ */
+auto cbc_prime(size_t n, const vector<double> &gamma) -> vector<size_t>;
+
+/**
+ * @brief Fast component-by-component construction of an embedded lattice
+ *
+ * The `cbc_embedded(m, gamma, m_min)` function constructs a generating
+ * vector for `LatticeSeq`, good for every 2^l points with
+ * m_min <= l <= m. Following Cools, Kuo and Nuyens, each component
+ * minimizes the worst ratio, over l, of the worst-case error to the best
+ * error attainable at level l; the group of odd residues modulo 2^l turns
+ * every level into a power-of-two FFT convolution, O(2^m m) per component.
+ *
+ * @param[in] m log2 of the largest number of points, m <= 32
+ * @param[in] gamma product weights
+ * @param[in] m_min smallest level taken into account
+ * @return vector<size_t> generating vector
+ */
+auto cbc_embedded(size_t m, const vector<double> &gamma, size_t m_min = 1)
+    -> vector<size_t>;
+
+/**
+ * @brief Save a generating vector to a text file
+ *
+ * The file holds the number of points `n` followed by the components of
+ * `z`, one number per line, so it can be read back by
+ * `load_generating_vector()` instead of repeating the search.
+ *
+ * @param[in] path
+ * @param[in] n
+ * @param[in] z
+ * @return true on success
+ */
+auto save_generating_vector(const std::string &path, size_t n,
+                            const vector<size_t> &z) -> bool;
+
+/**
+ * @brief Load a generating vector saved by `save_generating_vector()`
+ *
+ * @param[in] path
+ * @param[out] n
+ * @param[out] z
+ * @return true on success
+ */
+auto load_generating_vector(const std::string &path, size_t &n,
+                            vector<size_t> &z) -> bool;
+
+} // namespace lds2
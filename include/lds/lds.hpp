@@ -144,6 +144,30 @@ class Halton {
         return {this->vdc0.pop(), this->vdc1.pop()};
     }
 
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function generates the next `num`
+     * points and writes them row by row into `out`, which must hold
+     * `2 * num` doubles.
+     *
+     * @param out
+     * @param num
+     */
+    CONSTEXPR14 auto fill(double *out, size_t num) -> void {
+        for (size_t i = 0; i != num; ++i, out += 2) {
+            out[0] = this->vdc0.pop();
+            out[1] = this->vdc1.pop();
+        }
+    }
+
+    /**
+     * @brief Number of dimensions
+     *
+     * @return size_t
+     */
+    CONSTEXPR14 auto dimension() const -> size_t { return 2; }
+
     /**
      * @brief reseed
      *
@@ -1,10 +1,11 @@
 #pragma once
 
 #include <cassert>  // for assert
+#include <cmath>    // for cos, sin
 #include <stddef.h> // for size_t
 #include <vector>   // for vector
 
-#include "lds.hpp" // for VdCorput, Sphere
+#include "lds.hpp" // for VdCorput, Sphere, TWO_PI
 
 namespace lds2 {
 using std::vector;
@@ -66,6 +67,31 @@ class HaltonN {
         return res;
     }
 
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function generates the next `num`
+     * points and writes them row by row into `out`, which must hold
+     * `num * dim` doubles.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        for (size_t i = 0; i != num; ++i) {
+            for (auto &vdc : this->vdcs) {
+                *out++ = vdc.pop();
+            }
+        }
+    }
+
+    /**
+     * @brief Number of dimensions
+     *
+     * @return size_t
+     */
+    auto dimension() const -> size_t { return this->vdcs.size(); }
+
     /**
      * @brief reseed
      *
@@ -83,6 +109,92 @@ class HaltonN {
     }
 };
 
+/**
+ * @brief Torus T^n sequence generator
+ *
+ * The `TorusN` class generates points on the torus T^n, the product of n
+ * unit circles, one Van der Corput sequence per angle. Each point is written
+ * as n (cos, sin) pairs (note that `Circle::pop()` returns (sin, cos)).
+ * `fill()` first writes the angles of the whole batch, then computes all
+ * the cosines and sines in a single contiguous pass, which the compiler can
+ * turn into vector sincos calls, instead of one sin/cos call pair per circle
+ * per point.
+ */
+class TorusN {
+  private:
+    vector<VdCorput> vdcs;
+
+  public:
+    /**
+     * @brief Construct a new Torus N object
+     *
+     * @param[in] base one base per angle
+     */
+    explicit TorusN(const vector<size_t> &base) {
+        for (const auto &b : base) {
+            this->vdcs.emplace_back(VdCorput(b));
+        }
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function writes the next `num`
+     * points row by row into `out`, which must hold `2 * num * n` doubles:
+     * cos(theta_0), sin(theta_0), ..., cos(theta_n-1), sin(theta_n-1).
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        auto *p = out;
+        for (size_t i = 0; i != num; ++i) {
+            for (auto &vdc : this->vdcs) {
+                *p = vdc.pop() * TWO_PI;
+                p += 2;
+            }
+        }
+        const auto len = num * this->vdcs.size();
+        for (size_t i = 0; i != len; ++i) {
+            const auto theta = out[2 * i];
+            out[2 * i] = std::cos(theta);
+            out[2 * i + 1] = std::sin(theta);
+        }
+    }
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function returns the next point on the torus as a
+     * `std::vector<double>` of n (cos, sin) pairs.
+     *
+     * @return vector<double>
+     */
+    auto pop() -> vector<double> {
+        auto res = vector<double>(2 * this->vdcs.size());
+        this->fill(res.data(), 1);
+        return res;
+    }
+
+    /**
+     * @brief Number of coordinates per point, 2 n
+     *
+     * @return size_t
+     */
+    auto dimension() const -> size_t { return 2 * this->vdcs.size(); }
+
+    /**
+     * @brief reseed
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void {
+        for (auto &vdc : this->vdcs) {
+            vdc.reseed(seed);
+        }
+    }
+};
+
 // First 1000 prime numbers;
 static const size_t PRIME_TABLE[] = {
     2,    3,    5,    7,    11,   13,   17,   19,   23,   29,   31,   37,
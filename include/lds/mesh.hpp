@@ -0,0 +1,184 @@
+#pragma once
+
+#include <array>    // for array
+#include <cassert>  // for assert
+#include <cmath>    // for sqrt
+#include <cstdint>  // for uint32_t
+#include <stddef.h> // for size_t
+#include <vector>   // for vector
+
+#include "alias.hpp"    // for AliasTable
+#include "parallel.hpp" // for parallel_for
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Low-distortion map of the unit square onto a triangle
+ *
+ * The `square_to_triangle(u, v)` function returns barycentric coordinates
+ * (b0, b1) of a uniform point of the triangle, b2 = 1 - b0 - b1, using
+ * Heitz's map, which shears the square along its diagonal instead of
+ * folding it, so neighbouring samples stay neighbours.
+ *
+ * @param[in] u
+ * @param[in] v
+ * @return std::array<double, 2>
+ */
+inline auto square_to_triangle(double u, double v) -> std::array<double, 2> {
+    if (u < v) {
+        const auto b0 = u / 2.0;
+        return {b0, v - b0};
+    }
+    const auto b1 = v / 2.0;
+    return {u - b1, b1};
+}
+
+/**
+ * @brief Area-weighted sampler of a triangle mesh surface
+ *
+ * The `MeshSampler` class maps points (u0, u1, u2) of a 3D low-discrepancy
+ * sequence onto the surface of a triangle mesh: u0 selects a triangle with
+ * probability proportional to its area through an `AliasTable`, and
+ * (u1, u2) selects the position in the triangle with
+ * `square_to_triangle()`. The triangle areas and the alias table are
+ * computed in parallel. The vertex and index arrays are not copied and
+ * must outlive the sampler.
+ */
+class MeshSampler {
+    const double *vertices;  // x, y, z per vertex
+    const uint32_t *indices; // 3 vertex indices per triangle
+    AliasTable table;
+
+    static auto areas(const double *vertices, const uint32_t *indices,
+                      size_t num_triangles, size_t num_threads)
+        -> vector<double> {
+        auto res = vector<double>(num_triangles);
+        parallel_for(
+            0, num_triangles,
+            [&res, vertices, indices](size_t first, size_t last) {
+                for (auto t = first; t != last; ++t) {
+                    const auto *p0 = vertices + 3 * size_t(indices[3 * t]);
+                    const auto *p1 = vertices + 3 * size_t(indices[3 * t + 1]);
+                    const auto *p2 = vertices + 3 * size_t(indices[3 * t + 2]);
+                    const double e1[3] = {p1[0] - p0[0], p1[1] - p0[1],
+                                          p1[2] - p0[2]};
+                    const double e2[3] = {p2[0] - p0[0], p2[1] - p0[1],
+                                          p2[2] - p0[2]};
+                    const auto cx = e1[1] * e2[2] - e1[2] * e2[1];
+                    const auto cy = e1[2] * e2[0] - e1[0] * e2[2];
+                    const auto cz = e1[0] * e2[1] - e1[1] * e2[0];
+                    res[t] = 0.5 * std::sqrt(cx * cx + cy * cy + cz * cz);
+                }
+            },
+            num_threads);
+        return res;
+    }
+
+  public:
+    /**
+     * @brief Construct a new MeshSampler object
+     *
+     * @param[in] vertices vertex coordinates, x, y, z per vertex
+     * @param[in] indices vertex indices, 3 per triangle
+     * @param[in] num_triangles number of triangles, < 2^32
+     * @param[in] num_threads 0 for all hardware threads
+     */
+    MeshSampler(const double *vertices, const uint32_t *indices,
+                size_t num_triangles, size_t num_threads = 0)
+        : vertices{vertices}, indices{indices},
+          table(areas(vertices, indices, num_triangles, num_threads),
+                num_threads) {}
+
+    /**
+     * @brief at
+     *
+     * The `at(u0, u1, u2, tri)` function returns the surface point for the
+     * uniform numbers (u0, u1, u2) and stores the index of its triangle in
+     * `tri`.
+     *
+     * @param[in] u0 selects the triangle
+     * @param[in] u1
+     * @param[in] u2
+     * @param[out] tri
+     * @return std::array<double, 3>
+     */
+    auto at(double u0, double u1, double u2, size_t &tri) const
+        -> std::array<double, 3> {
+        tri = this->table.sample(u0);
+        const auto b = square_to_triangle(u1, u2);
+        const auto *p0 = this->vertices + 3 * size_t(this->indices[3 * tri]);
+        const auto *p1 =
+            this->vertices + 3 * size_t(this->indices[3 * tri + 1]);
+        const auto *p2 =
+            this->vertices + 3 * size_t(this->indices[3 * tri + 2]);
+        const auto b2 = 1.0 - b[0] - b[1];
+        return {b[0] * p0[0] + b[1] * p1[0] + b2 * p2[0],
+                b[0] * p0[1] + b[1] * p1[1] + b2 * p2[1],
+                b[0] * p0[2] + b[1] * p1[2] + b2 * p2[2]};
+    }
+
+    /**
+     * @brief map
+     *
+     * The `map(double *pts, size_t num, uint32_t *tri)` function replaces
+     * the `num` row-major uniform points (u0, u1, u2) in `pts` by their
+     * surface points, in parallel. If `tri` is not null, the triangle index
+     * of point k is written to `tri[k]`.
+     *
+     * @param[in,out] pts
+     * @param[in] num
+     * @param[out] tri
+     * @param[in] num_threads 0 for all hardware threads
+     */
+    auto map(double *pts, size_t num, uint32_t *tri = nullptr,
+             size_t num_threads = 0) const -> void {
+        parallel_for(
+            0, num,
+            [this, pts, tri](size_t first, size_t last) {
+                for (auto k = first; k != last; ++k) {
+                    auto *p = pts + 3 * k;
+                    auto t = size_t(0);
+                    const auto x = this->at(p[0], p[1], p[2], t);
+                    p[0] = x[0];
+                    p[1] = x[1];
+                    p[2] = x[2];
+                    if (tri != nullptr) {
+                        tri[k] = uint32_t(t);
+                    }
+                }
+            },
+            num_threads);
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(gen, out, num)` function draws the next `num` points of the
+     * 3D generator `gen` (e.g. `HaltonN({2, 3, 5})` or `Sobol(3)`) into
+     * `out`, which must hold `3 * num` doubles, and maps them onto the
+     * surface in parallel with `map()`.
+     *
+     * @param[in,out] gen
+     * @param[out] out
+     * @param[in] num
+     * @param[out] tri triangle indices, or null
+     * @param[in] num_threads 0 for all hardware threads
+     */
+    template <typename Gen>
+    auto fill(Gen &gen, double *out, size_t num, uint32_t *tri = nullptr,
+              size_t num_threads = 0) const -> void {
+        assert(gen.dimension() == 3);
+        gen.fill(out, num);
+        this->map(out, num, tri, num_threads);
+    }
+
+    /**
+     * @brief Total surface area
+     *
+     * @return double
+     */
+    auto area() const -> double { return this->table.sum(); }
+};
+
+} // namespace lds2
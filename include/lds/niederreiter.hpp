@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm> // for fill
+#include <cassert>   // for assert
+#include <cstdint>   // for uint64_t
+#include <stddef.h>  // for size_t
+#include <vector>    // for vector
+
+#include "sobol.hpp" // for trailing_zeros
+
+namespace lds2 {
+using std::vector;
+
+/** Number of bits of the generator matrix columns, i.e. at most 2^64 points */
+constexpr size_t NIED_BITS = 64;
+
+/**
+ * @brief Niederreiter sequence generator in base 2
+ *
+ * The `Niederreiter` class generates the base-2 Niederreiter sequence, a
+ * digital (t, s)-sequence built from the irreducible polynomials over GF(2)
+ * taken in increasing order (x, 1 + x, 1 + x + x^2, 1 + x + x^3, ...).
+ * Dimension j uses a polynomial of degree e_j, and the quality parameter is
+ * t = sum_j (e_j - 1). The irreducible polynomials include the primitive
+ * ones used by the Sobol sequence, so t is no higher than that of the Sobol
+ * sequence with the same number of dimensions; it is equal in low
+ * dimensions.
+ *
+ * The generator matrices are stored as packed 64-bit columns, bit-major as
+ * in `Sobol`, and points are produced in Gray-code order: each new point is
+ * the previous one XORed with one column per dimension.
+ */
+class Niederreiter {
+    size_t count;
+    size_t dim;
+    size_t tval;
+    vector<uint64_t> cols;  // matrix columns, bit-major: cols[bit * dim + j]
+    vector<uint64_t> state; // current point as 0.64 fixed point
+
+    static constexpr double SCALE = 1.0 / 9007199254740992.0; // 2^-53
+
+    /**
+     * @brief Advance the integer state to the next point
+     */
+    inline auto advance() -> void {
+        this->count += 1;
+        assert(this->count != 0U);
+        const auto *v = &this->cols[trailing_zeros(this->count) * this->dim];
+        auto *x = this->state.data();
+        for (size_t j = 0; j != this->dim; ++j) {
+            x[j] ^= v[j];
+        }
+    }
+
+    /**
+     * @brief Write the current point, keeping the top 53 bits
+     *
+     * @param[out] out
+     */
+    inline auto store(double *out) const -> void {
+        const auto *x = this->state.data();
+        for (size_t j = 0; j != this->dim; ++j) {
+            out[j] = double(x[j] >> 11U) * SCALE;
+        }
+    }
+
+  public:
+    /**
+     * @brief Construct a new Niederreiter object
+     *
+     * The `Niederreiter(size_t dim)` constructor builds the generator
+     * matrices of the first `dim` dimensions. The first dimension is the
+     * Van der Corput sequence in base 2 (in Gray-code order).
+     *
+     * @param[in] dim number of dimensions, dim >= 1
+     */
+    explicit Niederreiter(size_t dim);
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function returns the next point in the Niederreiter
+     * sequence as a `std::vector<double>` with `dim` coordinates in [0, 1).
+     *
+     * @return vector<double>
+     */
+    auto pop() -> vector<double> {
+        this->advance();
+        auto res = vector<double>(this->dim);
+        this->store(res.data());
+        return res;
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function generates the next `num`
+     * points and writes them row by row into `out`, which must hold
+     * `num * dim` doubles. The per-point loops run over contiguous columns
+     * and coordinates, so the compiler can vectorize them.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        for (size_t i = 0; i != num; ++i, out += this->dim) {
+            this->advance();
+            this->store(out);
+        }
+    }
+
+    /**
+     * @brief reseed
+     *
+     * The `reseed(size_t seed)` function is used to reset the state of the
+     * sequence generator to a specific seed value. As for `Sobol`, the state
+     * is the XOR of the columns selected by the Gray code of `seed`.
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void {
+        this->count = seed;
+        std::fill(this->state.begin(), this->state.end(), 0U);
+        auto gray = seed ^ (seed >> 1U);
+        for (size_t bit = 0; gray != 0U; ++bit, gray >>= 1U) {
+            if ((gray & 1U) != 0U) {
+                const auto *v = &this->cols[bit * this->dim];
+                for (size_t j = 0; j != this->dim; ++j) {
+                    this->state[j] ^= v[j];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief The quality parameter t of the sequence
+     *
+     * Every block of 2^m consecutive points, starting at a multiple of 2^m,
+     * is a (t, m, dim)-net in base 2.
+     *
+     * @return size_t
+     */
+    auto t_value() const -> size_t { return this->tval; }
+
+    /**
+     * @brief Number of dimensions
+     *
+     * @return size_t
+     */
+    auto dimension() const -> size_t { return this->dim; }
+};
+
+} // namespace lds2
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm> // for min, max
+#include <cmath>     // for abs, log, sqrt
+#include <stddef.h>  // for size_t
+
+namespace lds2 {
+
+/**
+ * @brief Evaluate a polynomial by Horner's rule
+ *
+ * @param[in] c coefficients, highest degree first
+ * @param[in] x
+ * @return double
+ */
+template <size_t N>
+inline auto horner(const double (&c)[N], double x) -> double {
+    auto s = c[0];
+    for (size_t i = 1; i != N; ++i) {
+        s = s * x + c[i];
+    }
+    return s;
+}
+
+/**
+ * @brief Inverse of the standard normal cumulative distribution function
+ *
+ * The `inv_norm_cdf(double p)` function returns x with Phi(x) = p, using
+ * Wichura's rational approximations (algorithm AS 241, PPND16), accurate to
+ * about 1e-16 relative. Low-discrepancy points may hit the endpoints (`vdc`
+ * returns exactly 0 for k = 0), so p is first clamped to
+ * [2^-53, 1 - 2^-53], which maps 0 and 1 to finite values of about -/+8.2
+ * instead of infinities.
+ *
+ * @param[in] p
+ * @return double
+ */
+inline auto inv_norm_cdf(double p) -> double {
+    static constexpr double A[] = {
+        2.5090809287301226727e+3, 3.3430575583588128105e+4,
+        6.7265770927008700853e+4, 4.5921953931549871457e+4,
+        1.3731693765509461125e+4, 1.9715909503065514427e+3,
+        1.3314166789178437745e+2, 3.3871328727963666080e+0};
+    static constexpr double B[] = {
+        5.2264952788528545610e+3, 2.8729085735721942674e+4,
+        3.9307895800092710610e+4, 2.1213794301586595867e+4,
+        5.3941960214247511077e+3, 6.8718700749205790830e+2,
+        4.2313330701600911252e+1, 1.0};
+    static constexpr double C[] = {
+        7.74545014278341407640e-4, 2.27238449892691845833e-2,
+        2.41780725177450611770e-1, 1.27045825245236838258e+0,
+        3.64784832476320460504e+0, 5.76949722146069140550e+0,
+        4.63033784615654529590e+0, 1.42343711074968357734e+0};
+    static constexpr double D[] = {
+        1.05075007164441684324e-9, 5.47593808499534494600e-4,
+        1.51986665636164571966e-2, 1.48103976427480074590e-1,
+        6.89767334985100004550e-1, 1.67638483018380384940e+0,
+        2.05319162663775882187e+0, 1.0};
+    static constexpr double E[] = {
+        2.01033439929228813265e-7, 2.71155556874348757815e-5,
+        1.24266094738807843860e-3, 2.65321895265761230930e-2,
+        2.96560571828504891230e-1, 1.78482653991729133580e+0,
+        5.46378491116411436990e+0, 6.65790464350110377720e+0};
+    static constexpr double F[] = {
+        2.04426310338993978564e-15, 1.42151175831644588870e-7,
+        1.84631831751005468180e-5,  7.86869131145613259100e-4,
+        1.48753612908506148525e-2,  1.36929880922735805310e-1,
+        5.99832206555887937690e-1,  1.0};
+
+    constexpr auto eps = 1.0 / 9007199254740992.0; // 2^-53
+    p = std::min(std::max(p, eps), 1.0 - eps);
+    const auto q = p - 0.5;
+    if (std::abs(q) <= 0.425) { // central region
+        const auto r = 0.180625 - q * q;
+        return q * horner(A, r) / horner(B, r);
+    }
+    const auto r = std::sqrt(-std::log(q < 0.0 ? p : 1.0 - p));
+    const auto x = r <= 5.0 ? horner(C, r - 1.6) / horner(D, r - 1.6)
+                            : horner(E, r - 5.0) / horner(F, r - 5.0);
+    return q < 0.0 ? -x : x;
+}
+
+/**
+ * @brief Batch inverse normal transform, in place
+ *
+ * The `inv_norm_cdf(double *x, size_t num)` function replaces each of the
+ * `num` values in `x` by `inv_norm_cdf(x[i])`, in one contiguous loop.
+ *
+ * @param[in,out] x
+ * @param[in] num
+ */
+inline auto inv_norm_cdf(double *x, size_t num) -> void {
+    for (size_t i = 0; i != num; ++i) {
+        x[i] = inv_norm_cdf(x[i]);
+    }
+}
+
+/**
+ * @brief Gaussian quasi-Monte Carlo points
+ *
+ * The `fill_normal(gen, out, num)` function generates the next `num` points
+ * of `gen` (any generator with `fill()` and `dimension()`, such as `HaltonN`
+ * or `Sobol`) and maps every coordinate to N(0, 1) with `inv_norm_cdf()`.
+ * The points are produced and transformed block by block, so each block is
+ * still in cache when it is transformed and the output is written in a
+ * single pass.
+ *
+ * @param[in,out] gen
+ * @param[out] out row-major buffer of `num * gen.dimension()` doubles
+ * @param[in] num
+ */
+template <typename Gen>
+auto fill_normal(Gen &gen, double *out, size_t num) -> void {
+    const auto dim = gen.dimension();
+    const auto block = std::max<size_t>(512 / std::max<size_t>(dim, 1), 1);
+    for (size_t i = 0; i < num; i += block) {
+        const auto len = std::min(block, num - i);
+        gen.fill(out + i * dim, len);
+        inv_norm_cdf(out + i * dim, len * dim);
+    }
+}
+
+} // namespace lds2
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <algorithm> // for min, max
+#include <stddef.h>  // for size_t
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+namespace lds2 {
+
+/**
+ * @brief Run a range function over [first, last) on several threads
+ *
+ * The `parallel_for(first, last, fn)` function splits [first, last) into
+ * contiguous chunks and calls `fn(begin, end)` for each chunk on its own
+ * thread, the first chunk on the calling thread. Ranges shorter than
+ * `grain` per thread use fewer threads, down to a plain call of `fn`. `fn`
+ * must not throw.
+ *
+ * @param[in] first
+ * @param[in] last
+ * @param[in] fn callable as fn(size_t begin, size_t end)
+ * @param[in] num_threads 0 for std::thread::hardware_concurrency()
+ * @param[in] grain minimum chunk length worth a thread
+ */
+template <typename Fn>
+auto parallel_for(size_t first, size_t last, Fn &&fn, size_t num_threads = 0,
+                  size_t grain = 4096) -> void {
+    if (last <= first) {
+        return;
+    }
+    const auto total = last - first;
+    if (num_threads == 0) {
+        num_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    num_threads = std::min(num_threads, std::max<size_t>(total / grain, 1));
+    const auto chunk = (total + num_threads - 1) / num_threads;
+    auto workers = std::vector<std::thread>{};
+    for (auto begin = first + chunk; begin < last; begin += chunk) {
+        const auto end = std::min(begin + chunk, last);
+        workers.emplace_back([&fn, begin, end]() { fn(begin, end); });
+    }
+    fn(first, std::min(first + chunk, last));
+    for (auto &w : workers) {
+        w.join();
+    }
+}
+
+} // namespace lds2
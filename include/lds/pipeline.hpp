@@ -0,0 +1,269 @@
+#pragma once
+
+#include <algorithm> // for max, min
+#include <cassert>   // for assert
+#include <cmath>     // for cos, sin, sqrt
+#include <stddef.h>  // for size_t
+#include <tuple>     // for tuple, apply
+#include <utility>   // for move
+#include <vector>    // for vector
+
+#include "lds.hpp"    // for TWO_PI
+#include "normal.hpp" // for inv_norm_cdf
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Affine map of a range of coordinates onto a box
+ *
+ * The `Affine` stage maps coordinate `first + i` from [0, 1) onto
+ * [lo[i], hi[i]).
+ */
+class Affine {
+    size_t first;
+    vector<double> lo;
+    vector<double> width;
+
+  public:
+    /**
+     * @brief Construct a new Affine object
+     *
+     * @param[in] lo lower corner of the box
+     * @param[in] hi upper corner of the box
+     * @param[in] first first coordinate to map
+     */
+    Affine(const vector<double> &lo, const vector<double> &hi,
+           size_t first = 0)
+        : first{first}, lo(lo), width(lo.size()) {
+        assert(hi.size() == lo.size());
+        for (size_t i = 0; i != lo.size(); ++i) {
+            this->width[i] = hi[i] - lo[i];
+        }
+    }
+
+    auto operator()(double *pts, size_t num, size_t dim) const -> void {
+        assert(this->first + this->lo.size() <= dim);
+        const auto *a = this->lo.data();
+        const auto *w = this->width.data();
+        for (size_t k = 0; k != num; ++k) {
+            auto *x = pts + k * dim + this->first;
+            for (size_t i = 0; i != this->lo.size(); ++i) {
+                x[i] = a[i] + w[i] * x[i];
+            }
+        }
+    }
+};
+
+/**
+ * @brief Scalar map of a range of coordinates
+ *
+ * The `Map` stage replaces each coordinate j, first <= j < last, by fn(x_j).
+ * Use `make_map()` to deduce the function type.
+ */
+template <typename Fn> class Map {
+    size_t first;
+    size_t last;
+    Fn fn;
+
+  public:
+    /**
+     * @brief Construct a new Map object
+     *
+     * @param[in] first
+     * @param[in] last
+     * @param[in] fn callable as double fn(double)
+     */
+    Map(size_t first, size_t last, Fn fn)
+        : first{first}, last{last}, fn(std::move(fn)) {}
+
+    auto operator()(double *pts, size_t num, size_t dim) const -> void {
+        assert(this->last <= dim);
+        for (size_t k = 0; k != num; ++k) {
+            auto *x = pts + k * dim;
+            for (auto j = this->first; j != this->last; ++j) {
+                x[j] = this->fn(x[j]);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Create a `Map` stage
+ *
+ * @param[in] first
+ * @param[in] last
+ * @param[in] fn
+ * @return Map<Fn>
+ */
+template <typename Fn>
+auto make_map(size_t first, size_t last, Fn fn) -> Map<Fn> {
+    return Map<Fn>(first, last, std::move(fn));
+}
+
+/**
+ * @brief Gaussian coordinates
+ *
+ * The `Gaussian` stage maps each coordinate j, first <= j < last, to
+ * N(0, 1) with `inv_norm_cdf()`.
+ */
+class Gaussian {
+    size_t first;
+    size_t last;
+
+  public:
+    /**
+     * @brief Construct a new Gaussian object
+     *
+     * @param[in] first
+     * @param[in] last
+     */
+    Gaussian(size_t first, size_t last) : first{first}, last{last} {}
+
+    auto operator()(double *pts, size_t num, size_t dim) const -> void {
+        assert(this->last <= dim);
+        if (this->first == 0 && this->last == dim) {
+            inv_norm_cdf(pts, num * dim);
+            return;
+        }
+        for (size_t k = 0; k != num; ++k) {
+            auto *x = pts + k * dim;
+            for (auto j = this->first; j != this->last; ++j) {
+                x[j] = inv_norm_cdf(x[j]);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Uniform disk coordinates
+ *
+ * The `PolarDisk` stage maps the pair of coordinates (u, v) at `first` and
+ * `first + 1` to the point sqrt(u) (cos 2 pi v, sin 2 pi v) of the unit disk,
+ * which preserves uniformity.
+ */
+class PolarDisk {
+    size_t first;
+
+  public:
+    /**
+     * @brief Construct a new PolarDisk object
+     *
+     * @param[in] first
+     */
+    explicit PolarDisk(size_t first = 0) : first{first} {}
+
+    auto operator()(double *pts, size_t num, size_t dim) const -> void {
+        assert(this->first + 2 <= dim);
+        for (size_t k = 0; k != num; ++k) {
+            auto *x = pts + k * dim + this->first;
+            const auto r = std::sqrt(x[0]);
+            const auto theta = TWO_PI * x[1];
+            x[0] = r * std::cos(theta);
+            x[1] = r * std::sin(theta);
+        }
+    }
+};
+
+/**
+ * @brief Fused transform pipeline over a point generator
+ *
+ * The `Pipeline` class attaches a list of transform stages to a generator
+ * with `fill()` and `dimension()` (`Halton`, `HaltonN`, `Sobol`, ...).
+ * `fill()` generates the points block by block, each block small enough to
+ * stay in the L1 cache, and runs every stage over the block before moving
+ * on, so the output buffer is written once instead of once per stage. A
+ * stage is any callable as stage(double *pts, size_t num, size_t dim) that
+ * transforms `num` row-major points in place; the stage types are template
+ * parameters, so the calls are resolved and inlined at compile time. Use
+ * `make_pipeline()` to deduce them.
+ */
+template <typename Gen, typename... Stages> class Pipeline {
+    Gen gen;
+    std::tuple<Stages...> stages;
+
+    static constexpr size_t BLOCK_DOUBLES = 2048; // 16 KiB
+
+    auto run(double *pts, size_t num) const -> void {
+        const auto dim = this->gen.dimension();
+        std::apply(
+            [pts, num, dim](const Stages &...stage) {
+                (stage(pts, num, dim), ...);
+            },
+            this->stages);
+    }
+
+  public:
+    /**
+     * @brief Construct a new Pipeline object
+     *
+     * @param[in] gen source generator
+     * @param[in] stages transforms, applied in order
+     */
+    explicit Pipeline(Gen gen, Stages... stages)
+        : gen(std::move(gen)), stages(std::move(stages)...) {}
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function returns the next transformed point as a
+     * `std::vector<double>`.
+     *
+     * @return vector<double>
+     */
+    auto pop() -> vector<double> {
+        auto res = vector<double>(this->gen.dimension());
+        this->fill(res.data(), 1);
+        return res;
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function generates the next `num`
+     * transformed points and writes them row by row into `out`, which must
+     * hold `num * dim` doubles.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        const auto dim = this->gen.dimension();
+        const auto block = std::max<size_t>(BLOCK_DOUBLES / dim, 1);
+        for (size_t i = 0; i < num; i += block) {
+            const auto len = std::min(block, num - i);
+            this->gen.fill(out + i * dim, len);
+            this->run(out + i * dim, len);
+        }
+    }
+
+    /**
+     * @brief reseed
+     *
+     * The `reseed(size_t seed)` function reseeds the source generator.
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void { this->gen.reseed(seed); }
+
+    /**
+     * @brief Number of dimensions
+     *
+     * @return size_t
+     */
+    auto dimension() const -> size_t { return this->gen.dimension(); }
+};
+
+/**
+ * @brief Create a `Pipeline`
+ *
+ * @param[in] gen source generator
+ * @param[in] stages transforms, applied in order
+ * @return Pipeline<Gen, Stages...>
+ */
+template <typename Gen, typename... Stages>
+auto make_pipeline(Gen gen, Stages... stages) -> Pipeline<Gen, Stages...> {
+    return Pipeline<Gen, Stages...>(std::move(gen), std::move(stages)...);
+}
+
+} // namespace lds2
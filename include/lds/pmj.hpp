@@ -0,0 +1,182 @@
+#pragma once
+
+#include <array>    // for array
+#include <cassert>  // for assert
+#include <cstdint>  // for uint32_t, uint64_t
+#include <stddef.h> // for size_t
+#include <vector>   // for vector
+
+#include "parallel.hpp" // for parallel_for
+#include "scramble.hpp" // for owen_scramble, reverse_bits32, hash32
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Progressive (0, 2)-stratified 2D sample sequence
+ *
+ * The `Pmj02` class generates 2D samples such that every prefix of 2^m
+ * samples puts exactly one sample into each elementary interval of area
+ * 2^-m (all 2^a x 2^b grids with a + b = m), and in particular is
+ * multi-jittered, which `Halton(2, 3)` does not guarantee. Sample k is the
+ * k-th point of the (0, 2)-sequence in base 2 (the first two Sobol
+ * dimensions), with each coordinate Owen-scrambled by a seed derived from
+ * `seed`. This is not the pmj02 algorithm of Christensen et al., which
+ * picks the samples by a randomized candidate search; it meets the same
+ * (0, 2) stratification goal with scrambled Sobol points instead, at O(1)
+ * per sample and with random access by index. Different seeds give
+ * independent sequences, e.g. one per pixel.
+ */
+class Pmj02 {
+    size_t count;
+    uint32_t seed_x;
+    uint32_t seed_y;
+
+  public:
+    /**
+     * @brief Construct a new Pmj02 object
+     *
+     * @param[in] seed
+     */
+    explicit Pmj02(uint32_t seed = 0)
+        : count{0}, seed_x{hash32(hash32(seed))},
+          seed_y{hash32(hash32(seed) ^ 1U)} {}
+
+    /**
+     * @brief at
+     *
+     * The `at(size_t k)` function returns sample k, k < 2^32, without
+     * touching the generator state. The second coordinate is the product of
+     * k with the Pascal matrix over GF(2), one XOR per bit of k.
+     *
+     * @param[in] k
+     * @return std::array<double, 2>
+     */
+    auto at(size_t k) const -> std::array<double, 2> {
+        assert((uint64_t(k) >> 32U) == 0U);
+        auto y = uint32_t(0);
+        for (auto a = uint32_t(k), v = 1U << 31U; a != 0U;
+             a >>= 1U, v ^= v >> 1U) {
+            y ^= (a & 1U) != 0U ? v : 0U;
+        }
+        const auto x = reverse_bits32(uint32_t(k));
+        return {double(owen_scramble(x, this->seed_x)) / 4294967296.0,
+                double(owen_scramble(y, this->seed_y)) / 4294967296.0};
+    }
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function returns the next sample. Unlike the sequences of
+     * points, the samples start at k = 0, so that the first 2^m calls give
+     * a complete stratified prefix.
+     *
+     * @return std::array<double, 2>
+     */
+    auto pop() -> std::array<double, 2> { return this->at(this->count++); }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *x, double *y, size_t num)` function writes samples
+     * 0, ..., num - 1 into the arrays `x` and `y` of length `num`, computed
+     * in parallel.
+     *
+     * @param[out] x
+     * @param[out] y
+     * @param[in] num
+     * @param[in] num_threads 0 for all hardware threads
+     */
+    auto fill(double *x, double *y, size_t num, size_t num_threads = 0) const
+        -> void {
+        parallel_for(
+            0, num,
+            [this, x, y](size_t first, size_t last) {
+                for (auto k = first; k != last; ++k) {
+                    const auto s = this->at(k);
+                    x[k] = s[0];
+                    y[k] = s[1];
+                }
+            },
+            num_threads);
+    }
+
+    /**
+     * @brief reseed
+     *
+     * The `reseed(size_t seed)` function is used to reset the state of the
+     * sequence generator to a specific sample index.
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void { this->count = seed; }
+};
+
+/**
+ * @brief Precomputed table of `Pmj02` samples
+ *
+ * The `Pmj02Table` class precomputes the first n samples of a `Pmj02`
+ * sequence, in parallel, and then serves them by table lookup. `pop()`
+ * wraps around after n samples.
+ */
+class Pmj02Table {
+    size_t count;
+    vector<double> xs;
+    vector<double> ys;
+
+  public:
+    /**
+     * @brief Construct a new Pmj02Table object
+     *
+     * @param[in] n number of samples, preferably a power of two
+     * @param[in] seed
+     * @param[in] num_threads 0 for all hardware threads
+     */
+    Pmj02Table(size_t n, uint32_t seed = 0, size_t num_threads = 0)
+        : count{0}, xs(n), ys(n) {
+        assert(n >= 1);
+        Pmj02(seed).fill(this->xs.data(), this->ys.data(), n, num_threads);
+    }
+
+    /**
+     * @brief at
+     *
+     * @param[in] k
+     * @return std::array<double, 2>
+     */
+    auto at(size_t k) const -> std::array<double, 2> {
+        return {this->xs[k], this->ys[k]};
+    }
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function returns the next sample of the table.
+     *
+     * @return std::array<double, 2>
+     */
+    auto pop() -> std::array<double, 2> {
+        const auto k = this->count;
+        this->count = k + 1 == this->xs.size() ? 0 : k + 1;
+        return this->at(k);
+    }
+
+    /**
+     * @brief reseed
+     *
+     * The `reseed(size_t seed)` function is used to reset the state of the
+     * sequence generator to a specific sample index.
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void { this->count = seed % this->xs.size(); }
+
+    /**
+     * @brief Number of samples in the table
+     *
+     * @return size_t
+     */
+    auto size() const -> size_t { return this->xs.size(); }
+};
+
+} // namespace lds2
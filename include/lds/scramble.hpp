@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>  // for uint32_t
+#include <stddef.h> // for size_t
+
+#include "lds.hpp" // for CONSTEXPR14
+
+namespace lds2 {
+
+/**
+ * @brief Reverse the bits of a 32-bit word
+ *
+ * @param x
+ * @return uint32_t
+ */
+CONSTEXPR14 auto reverse_bits32(uint32_t x) -> uint32_t {
+    x = ((x >> 1U) & 0x55555555U) | ((x & 0x55555555U) << 1U);
+    x = ((x >> 2U) & 0x33333333U) | ((x & 0x33333333U) << 2U);
+    x = ((x >> 4U) & 0x0F0F0F0FU) | ((x & 0x0F0F0F0FU) << 4U);
+    x = ((x >> 8U) & 0x00FF00FFU) | ((x & 0x00FF00FFU) << 8U);
+    return (x >> 16U) | (x << 16U);
+}
+
+/**
+ * @brief 32-bit integer hash
+ *
+ * A bijective avalanche hash (lowbias32 by C. Wellons), used to derive
+ * decorrelated per-dimension seeds from a single user seed.
+ *
+ * @param x
+ * @return uint32_t
+ */
+CONSTEXPR14 auto hash32(uint32_t x) -> uint32_t {
+    x ^= x >> 16U;
+    x *= 0x7feb352dU;
+    x ^= x >> 15U;
+    x *= 0x846ca68bU;
+    x ^= x >> 16U;
+    return x;
+}
+
+/**
+ * @brief Nested uniform (Owen) scrambling of a 32-bit binary fraction
+ *
+ * The `owen_scramble(x, seed)` function applies a hash-based nested uniform
+ * scrambling to the binary digits of `x` (most significant digit first).
+ * Each digit is flipped depending only on the digits above it, as in Owen's
+ * scrambling, but the random flips are drawn from the Laine-Karras style hash
+ * of Burley (2020) instead of a stored permutation tree. The hash acts on the
+ * bit-reversed word, where "depends only on lower bits" is exactly what
+ * multiplication and addition provide.
+ *
+ * @param x 32-bit binary fraction, i.e. the value x / 2^32
+ * @param seed scramble seed
+ * @return uint32_t
+ */
+CONSTEXPR14 auto owen_scramble(uint32_t x, uint32_t seed) -> uint32_t {
+    x = reverse_bits32(x);
+    x ^= x * 0x3d20adeaU;
+    x += seed;
+    x *= (seed >> 16U) | 1U;
+    x ^= x * 0x05526c56U;
+    x ^= x * 0x53a22864U;
+    return reverse_bits32(x);
+}
+
+/**
+ * @brief Owen-scrambled Van der Corput sequence generator in base 2
+ *
+ * The `ScrambledVdCorput` class generates a randomized Van der Corput
+ * sequence in base 2. The unscrambled value for `count` is its bit reversal,
+ * so each point costs one bit reversal and one `owen_scramble()`. Distinct
+ * seeds give independent replicates for randomized quasi-Monte Carlo error
+ * estimates.
+ */
+class ScrambledVdCorput {
+    size_t count;
+    uint32_t seed;
+
+  public:
+    /**
+     * @brief Construct a new ScrambledVdCorput object
+     *
+     * @param[in] seed scramble seed selecting the replicate
+     */
+    CONSTEXPR14 explicit ScrambledVdCorput(uint32_t seed)
+        : count{0}, seed{hash32(seed)} {}
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function increments the count and returns the scrambled
+     * Van der Corput value for that count in [0, 1).
+     *
+     * @return double
+     */
+    CONSTEXPR14 auto pop() -> double {
+        this->count += 1;
+        const auto x = reverse_bits32(uint32_t(this->count));
+        return double(owen_scramble(x, this->seed)) / 4294967296.0;
+    }
+
+    /**
+     * @brief reseed
+     *
+     * The `reseed(size_t seed)` function is used to reset the state of the
+     * sequence generator to a specific point in the sequence. The scramble
+     * seed is kept.
+     *
+     * @param[in] seed
+     */
+    CONSTEXPR14 auto reseed(size_t seed) -> void { this->count = seed; }
+};
+
+} // namespace lds2
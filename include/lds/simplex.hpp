@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm> // for max, min
+#include <cassert>   // for assert
+#include <cmath>     // for log
+#include <stddef.h>  // for size_t
+#include <vector>    // for vector
+
+#include "lds_n.hpp" // for HaltonN
+
+namespace lds2 {
+using std::vector;
+
+/**
+ * @brief Batch exponential spacings, in place
+ *
+ * The `exp_spacings(double *x, size_t num)` function replaces each of the
+ * `num` uniform values u in `x` by the standard exponential variate
+ * -log(1 - u). It is one contiguous loop, which the compiler can vectorize
+ * when a vector math library is available. 1 - u is used rather than u so
+ * that a coordinate equal to 0 (the first point of `Sobol`) stays finite.
+ *
+ * @param[in,out] x
+ * @param[in] num
+ */
+inline auto exp_spacings(double *x, size_t num) -> void {
+    for (size_t i = 0; i != num; ++i) {
+        x[i] = -std::log(1.0 - x[i]);
+    }
+}
+
+/**
+ * @brief Map uniform points onto the probability simplex, in place
+ *
+ * The `to_simplex(x, num, dim)` function maps each of the `num` row-major
+ * points of [0, 1)^dim in `x` to the point (e_1, ..., e_dim) / sum(e) of
+ * the simplex {p_i >= 0, sum(p_i) = 1}, where e_i = -log(1 - u_i). The
+ * normalized exponential spacings are uniformly distributed on the
+ * simplex, so this costs O(dim) per point instead of the O(dim log dim) of
+ * the sort-based construction. A point whose coordinates are all 0 maps to
+ * the barycenter.
+ *
+ * @param[in,out] x
+ * @param[in] num
+ * @param[in] dim
+ */
+inline auto to_simplex(double *x, size_t num, size_t dim) -> void {
+    exp_spacings(x, num * dim);
+    for (size_t k = 0; k != num; ++k, x += dim) {
+        auto sum = 0.0;
+        for (size_t j = 0; j != dim; ++j) {
+            sum += x[j];
+        }
+        const auto scale = sum > 0.0 ? 1.0 / sum : 0.0;
+        const auto bias = sum > 0.0 ? 0.0 : 1.0 / double(dim);
+        for (size_t j = 0; j != dim; ++j) {
+            x[j] = x[j] * scale + bias;
+        }
+    }
+}
+
+/**
+ * @brief Uniform quasi-Monte Carlo points on the simplex
+ *
+ * The `fill_simplex(gen, out, num)` function generates the next `num` points
+ * of `gen` (any generator with `fill()` and `dimension()`, such as
+ * `HaltonN`) and maps them onto the simplex with `to_simplex()`, block by
+ * block, directly in `out`. Nothing is allocated.
+ *
+ * @param[in,out] gen
+ * @param[out] out row-major buffer of `num * gen.dimension()` doubles
+ * @param[in] num
+ */
+template <typename Gen>
+auto fill_simplex(Gen &gen, double *out, size_t num) -> void {
+    const auto dim = gen.dimension();
+    const auto block = std::max<size_t>(512 / std::max<size_t>(dim, 1), 1);
+    for (size_t i = 0; i < num; i += block) {
+        const auto len = std::min(block, num - i);
+        gen.fill(out + i * dim, len);
+        to_simplex(out + i * dim, len, dim);
+    }
+}
+
+/**
+ * @brief Dirichlet sequence generator with integer concentrations
+ *
+ * The `Dirichlet` class generates points distributed as
+ * Dirichlet(k_1, ..., k_d) for positive integers k_i. A Gamma(k, 1) variate
+ * is the sum of k independent exponential spacings, so a point consumes
+ * K = k_1 + ... + k_d coordinates of a `HaltonN` sequence: component i sums
+ * the spacings of its k_i coordinates, and the result is normalized. With
+ * all k_i = 1 this is the uniform simplex of `to_simplex()`. The scratch
+ * block is allocated once at construction; `fill()` does not allocate.
+ */
+class Dirichlet {
+    HaltonN halton;
+    vector<size_t> shape;
+    vector<double> buf; // scratch block of uniforms
+    size_t block;       // points per scratch block
+
+  public:
+    /**
+     * @brief Construct a new Dirichlet object
+     *
+     * @param[in] shape concentrations k_i >= 1
+     * @param[in] base K = sum(k_i) bases, e.g. from `PRIME_TABLE`
+     */
+    Dirichlet(const vector<size_t> &shape, const vector<size_t> &base)
+        : halton(base), shape(shape) {
+        auto total = size_t(0);
+        for (const auto &k : shape) {
+            assert(k >= 1);
+            total += k;
+        }
+        assert(total == base.size());
+        this->block = std::max<size_t>(512 / std::max<size_t>(total, 1), 1);
+        this->buf.resize(this->block * total);
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function writes the next `num`
+     * points row by row into `out`, which must hold `num * dimension()`
+     * doubles.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        const auto total = this->halton.dimension();
+        const auto dim = this->shape.size();
+        for (size_t i = 0; i < num; i += this->block) {
+            const auto len = std::min(this->block, num - i);
+            this->halton.fill(this->buf.data(), len);
+            exp_spacings(this->buf.data(), len * total);
+            for (size_t k = 0; k != len; ++k) {
+                const auto *e = &this->buf[k * total];
+                auto *x = out + (i + k) * dim;
+                auto sum = 0.0;
+                for (size_t j = 0; j != dim; ++j) {
+                    auto g = 0.0;
+                    for (size_t m = 0; m != this->shape[j]; ++m) {
+                        g += *e++;
+                    }
+                    x[j] = g;
+                    sum += g;
+                }
+                for (size_t j = 0; j != dim; ++j) {
+                    x[j] /= sum;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function returns the next point as a
+     * `std::vector<double>`.
+     *
+     * @return vector<double>
+     */
+    auto pop() -> vector<double> {
+        auto res = vector<double>(this->shape.size());
+        this->fill(res.data(), 1);
+        return res;
+    }
+
+    /**
+     * @brief Number of components
+     *
+     * @return size_t
+     */
+    auto dimension() const -> size_t { return this->shape.size(); }
+
+    /**
+     * @brief reseed
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void { this->halton.reseed(seed); }
+};
+
+} // namespace lds2
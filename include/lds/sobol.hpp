@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm> // for fill
+#include <cassert>   // for assert
+#include <cstdint>   // for uint32_t
+#include <stddef.h>  // for size_t
+#include <vector>    // for vector
+
+#include "lds.hpp"      // for CONSTEXPR14
+#include "scramble.hpp" // for owen_scramble, hash32
+
+namespace lds2 {
+using std::vector;
+
+/** Maximum dimension covered by the bundled Joe-Kuo direction numbers */
+constexpr size_t SOBOL_MAX_DIM = 3667;
+
+/** Number of bits of the direction numbers, i.e. at most 2^32 points */
+constexpr size_t SOBOL_BITS = 32;
+
+/**
+ * @brief Number of trailing zero bits
+ *
+ * Returns the index of the lowest set bit of `k`, i.e. the bit position in
+ * which the Gray codes of `k - 1` and `k` differ. `k` must be nonzero.
+ *
+ * @param k
+ * @return size_t
+ */
+CONSTEXPR14 auto trailing_zeros(size_t k) -> size_t {
+    auto c = size_t(0);
+    for (; (k & 1U) == 0U; k >>= 1U) {
+        ++c;
+    }
+    return c;
+}
+
+/**
+ * @brief Sobol sequence generator
+ *
+ * The `Sobol` class generates points of the Sobol sequence in up to
+ * `SOBOL_MAX_DIM` dimensions, using the direction numbers of Joe and Kuo.
+ * Points are produced in Gray-code order (Antonov-Saleev), so that each new
+ * point differs from the previous one by a single direction number per
+ * dimension: one XOR and one scale per coordinate. Like `HaltonN`, `pop()`
+ * returns the next point as a `std::vector<double>`; `fill()` writes a batch
+ * of points into a caller-provided buffer. `scramble()` turns on hash-based
+ * Owen scrambling for randomized quasi-Monte Carlo.
+ */
+class Sobol {
+    size_t count;
+    size_t dim;
+    vector<uint32_t> dirs;  // direction numbers, bit-major: dirs[bit * dim + j]
+    vector<uint32_t> state; // current point as 32-bit integers
+    vector<uint32_t> seeds; // per-dimension Owen scramble seeds, or empty
+
+    static constexpr double SCALE = 1.0 / 4294967296.0; // 2^-32
+
+    /**
+     * @brief Advance the integer state to the next point
+     */
+    inline auto advance() -> void {
+        this->count += 1;
+        assert(this->count >> SOBOL_BITS == 0U);
+        const auto *v = &this->dirs[trailing_zeros(this->count) * this->dim];
+        auto *x = this->state.data();
+        for (size_t j = 0; j != this->dim; ++j) {
+            x[j] ^= v[j];
+        }
+    }
+
+    /**
+     * @brief Write the current point, scrambled if enabled
+     *
+     * @param[out] out
+     */
+    inline auto store(double *out) const -> void {
+        const auto *x = this->state.data();
+        if (this->seeds.empty()) {
+            for (size_t j = 0; j != this->dim; ++j) {
+                out[j] = double(x[j]) * SCALE;
+            }
+        } else {
+            const auto *s = this->seeds.data();
+            for (size_t j = 0; j != this->dim; ++j) {
+                out[j] = double(owen_scramble(x[j], s[j])) * SCALE;
+            }
+        }
+    }
+
+  public:
+    /**
+     * @brief Construct a new Sobol object
+     *
+     * The `Sobol(size_t dim)` constructor builds the direction numbers of the
+     * first `dim` dimensions from the bundled primitive polynomials and
+     * initial values. The first dimension is the Van der Corput sequence in
+     * base 2 (in Gray-code order).
+     *
+     * @param[in] dim number of dimensions, 1 <= dim <= SOBOL_MAX_DIM
+     */
+    explicit Sobol(size_t dim);
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function is used to generate the next value in the sequence.
+     * In the `Sobol` class, `pop()` returns the next point in the Sobol
+     * sequence as a `std::vector<double>` with `dim` coordinates in [0, 1).
+     *
+     * @return vector<double>
+     */
+    auto pop() -> vector<double> {
+        this->advance();
+        auto res = vector<double>(this->dim);
+        this->store(res.data());
+        return res;
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function generates the next `num`
+     * points and writes them row by row into `out`, which must hold
+     * `num * dim` doubles. The per-point loops run over contiguous direction
+     * numbers and coordinates, so the compiler can vectorize them.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        for (size_t i = 0; i != num; ++i, out += this->dim) {
+            this->advance();
+            this->store(out);
+        }
+    }
+
+    /**
+     * @brief reseed
+     *
+     * The `reseed(size_t seed)` function is used to reset the state of the
+     * sequence generator to a specific seed value. The state for point `seed`
+     * is the XOR of the direction numbers selected by the bits of its Gray
+     * code, so jumping ahead costs O(32 * dim) regardless of `seed`.
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void {
+        assert(seed >> SOBOL_BITS == 0U);
+        this->count = seed;
+        std::fill(this->state.begin(), this->state.end(), 0U);
+        auto gray = seed ^ (seed >> 1U);
+        for (size_t bit = 0; gray != 0U; ++bit, gray >>= 1U) {
+            if ((gray & 1U) != 0U) {
+                const auto *v = &this->dirs[bit * this->dim];
+                for (size_t j = 0; j != this->dim; ++j) {
+                    this->state[j] ^= v[j];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief scramble
+     *
+     * The `scramble(uint32_t seed)` function enables nested uniform (Owen)
+     * scrambling of all coordinates with `owen_scramble()`. Each dimension
+     * gets its own seed hashed from `seed` and the dimension index, so
+     * different seeds select independent replicates. The scrambled points
+     * remain a (t, s)-sequence in base 2.
+     *
+     * @param[in] seed
+     */
+    auto scramble(uint32_t seed) -> void {
+        this->seeds.resize(this->dim);
+        for (size_t j = 0; j != this->dim; ++j) {
+            this->seeds[j] = hash32(hash32(seed) ^ uint32_t(j));
+        }
+    }
+
+    /**
+     * @brief Number of dimensions
+     *
+     * @return size_t
+     */
+    auto dimension() const -> size_t { return this->dim; }
+};
+
+} // namespace lds2
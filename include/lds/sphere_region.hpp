@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm> // for max
+#include <array>     // for array
+#include <cassert>   // for assert
+#include <cmath>     // for copysign, cos, sin, sqrt
+#include <stddef.h>  // for size_t
+
+#include "lds.hpp" // for VdCorput, Circle, TWO_PI
+
+namespace lds2 {
+
+/**
+ * @brief Spherical cap sequence generator
+ *
+ * The `SphericalCap` class generates points on the cap of the unit sphere
+ * within angle `angle` of the direction `axis`. It is the construction of
+ * `Sphere` with the height remapped: by Archimedes' theorem the height
+ * along the axis of a uniform point is uniform, so z = 1 - vdc (1 - cos a)
+ * covers [cos a, 1] with the same low discrepancy as `vdc` covers [0, 1),
+ * and the azimuth comes from `Circle`. Every point lands in the cap; there
+ * is no rejection.
+ */
+class SphericalCap {
+    VdCorput vdcgen;
+    Circle cirgen;
+    double height; // 1 - cos(angle)
+    std::array<double, 3> axis;
+    std::array<double, 3> t1;
+    std::array<double, 3> t2;
+
+  public:
+    /**
+     * @brief Construct a new SphericalCap object
+     *
+     * @param[in] axis direction of the center of the cap, nonzero
+     * @param[in] angle angular radius in radians, 0 < angle <= pi
+     * @param[in] base0 base of the height
+     * @param[in] base1 base of the azimuth
+     */
+    SphericalCap(const std::array<double, 3> &axis, double angle, size_t base0,
+                 size_t base1)
+        : vdcgen(base0), cirgen(base1), height{1.0 - std::cos(angle)} {
+        const auto r = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] +
+                                 axis[2] * axis[2]);
+        assert(r > 0.0);
+        const auto n = std::array<double, 3>{axis[0] / r, axis[1] / r,
+                                             axis[2] / r};
+        // orthonormal frame around n (Duff et al.), branch-free
+        const auto sign = std::copysign(1.0, n[2]);
+        const auto a = -1.0 / (sign + n[2]);
+        const auto b = n[0] * n[1] * a;
+        this->axis = n;
+        this->t1 = {1.0 + sign * n[0] * n[0] * a, sign * b, -sign * n[0]};
+        this->t2 = {b, sign + n[1] * n[1] * a, -n[1]};
+    }
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function returns the next point on the cap as a
+     * `std::array<double, 3>`.
+     *
+     * @return std::array<double, 3>
+     */
+    auto pop() -> std::array<double, 3> {
+        const auto z = 1.0 - this->vdcgen.pop() * this->height;
+        const auto s = std::sqrt(std::max(0.0, 1.0 - z * z));
+        const auto c = this->cirgen.pop();
+        const auto x = s * c[0];
+        const auto y = s * c[1];
+        return {x * this->t1[0] + y * this->t2[0] + z * this->axis[0],
+                x * this->t1[1] + y * this->t2[1] + z * this->axis[1],
+                x * this->t1[2] + y * this->t2[2] + z * this->axis[2]};
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function writes the next `num`
+     * points row by row into `out`, which must hold `3 * num` doubles.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        for (size_t i = 0; i != num; ++i, out += 3) {
+            const auto p = this->pop();
+            out[0] = p[0];
+            out[1] = p[1];
+            out[2] = p[2];
+        }
+    }
+
+    /**
+     * @brief reseed
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void {
+        this->vdcgen.reseed(seed);
+        this->cirgen.reseed(seed);
+    }
+};
+
+/**
+ * @brief Latitude/longitude band sequence generator
+ *
+ * The `LatLongBand` class generates points on the part of the unit sphere
+ * with latitude in [lat_min, lat_max] and longitude in
+ * [lon_min, lon_max), in radians. As for `SphericalCap`, the height
+ * z = sin(latitude) is uniform in [sin(lat_min), sin(lat_max)] and the
+ * longitude is uniform, so two Van der Corput sequences are remapped
+ * linearly and no point is rejected. The default longitude range is the
+ * whole circle, i.e. a latitude band.
+ */
+class LatLongBand {
+    VdCorput vdc0;
+    VdCorput vdc1;
+    double z0;
+    double dz;
+    double lon0;
+    double dlon;
+
+  public:
+    /**
+     * @brief Construct a new LatLongBand object
+     *
+     * @param[in] lat_min
+     * @param[in] lat_max
+     * @param[in] base0 base of the height
+     * @param[in] base1 base of the longitude
+     * @param[in] lon_min
+     * @param[in] lon_max
+     */
+    LatLongBand(double lat_min, double lat_max, size_t base0, size_t base1,
+                double lon_min = 0.0, double lon_max = TWO_PI)
+        : vdc0(base0), vdc1(base1), z0{std::sin(lat_min)},
+          dz{std::sin(lat_max) - std::sin(lat_min)}, lon0{lon_min},
+          dlon{lon_max - lon_min} {
+        assert(lat_min <= lat_max && lon_min <= lon_max);
+    }
+
+    /**
+     * @brief pop
+     *
+     * The `pop()` function returns the next point in the band as a
+     * `std::array<double, 3>`.
+     *
+     * @return std::array<double, 3>
+     */
+    auto pop() -> std::array<double, 3> {
+        const auto z = this->z0 + this->vdc0.pop() * this->dz;
+        const auto s = std::sqrt(std::max(0.0, 1.0 - z * z));
+        const auto lon = this->lon0 + this->vdc1.pop() * this->dlon;
+        return {s * std::cos(lon), s * std::sin(lon), z};
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function writes the next `num`
+     * points row by row into `out`, which must hold `3 * num` doubles.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        for (size_t i = 0; i != num; ++i, out += 3) {
+            const auto p = this->pop();
+            out[0] = p[0];
+            out[1] = p[1];
+            out[2] = p[2];
+        }
+    }
+
+    /**
+     * @brief reseed
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void {
+        this->vdc0.reseed(seed);
+        this->vdc1.reseed(seed);
+    }
+};
+
+} // namespace lds2
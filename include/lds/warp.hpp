@@ -0,0 +1,307 @@
+#pragma once
+
+#include <algorithm> // for max, min
+#include <array>     // for array
+#include <cmath>     // for abs, cos, sin, sqrt
+#include <stddef.h>  // for size_t
+
+#include "lds.hpp" // for Halton, M_PI
+
+namespace lds2 {
+
+/**
+ * @brief Concentric (Shirley-Chiu) map of the unit square onto the unit disk
+ *
+ * The `concentric_disk(u, v)` function maps concentric squares of
+ * [0, 1)^2 to concentric circles, preserving area and keeping the
+ * stratification of the input far less distorted than the polar map. In
+ * Cline's form it needs one sine and one cosine of an angle in
+ * [-pi/4, pi/4] + k pi/2.
+ *
+ * @param[in] u
+ * @param[in] v
+ * @return std::array<double, 2>
+ */
+inline auto concentric_disk(double u, double v) -> std::array<double, 2> {
+    const auto a = 2.0 * u - 1.0;
+    const auto b = 2.0 * v - 1.0;
+    if (a == 0.0 && b == 0.0) {
+        return {0.0, 0.0};
+    }
+    const auto major = std::abs(a) > std::abs(b);
+    const auto r = major ? a : b;
+    const auto phi = major ? (M_PI / 4.0) * (b / a)
+                           : (M_PI / 2.0) - (M_PI / 4.0) * (a / b);
+    return {r * std::cos(phi), r * std::sin(phi)};
+}
+
+/**
+ * @brief Cosine-weighted direction on the upper hemisphere
+ *
+ * The `cosine_hemisphere(u, v)` function lifts `concentric_disk(u, v)` onto
+ * the hemisphere (Malley's method): z = sqrt(1 - x^2 - y^2), so the
+ * density is cos(theta) / pi without further trigonometry.
+ *
+ * @param[in] u
+ * @param[in] v
+ * @return std::array<double, 3>
+ */
+inline auto cosine_hemisphere(double u, double v) -> std::array<double, 3> {
+    const auto d = concentric_disk(u, v);
+    const auto z = std::sqrt(std::max(0.0, 1.0 - d[0] * d[0] - d[1] * d[1]));
+    return {d[0], d[1], z};
+}
+
+/**
+ * @brief Uniform direction in a cone around +z
+ *
+ * The `uniform_cone(u, v, cos_max)` function returns a direction uniformly
+ * distributed over the cone cos(theta) >= cos_max. The squared radius r^2
+ * of `concentric_disk(u, v)` is uniform, so z = 1 - r^2 (1 - cos_max) is
+ * uniform in [cos_max, 1], and the disk point is rescaled by
+ * sqrt((1 - cos_max)(1 + z)) to reach the unit sphere. `cos_max = 0` gives
+ * the uniform hemisphere, `cos_max = -1` the uniform sphere.
+ *
+ * @param[in] u
+ * @param[in] v
+ * @param[in] cos_max cosine of the half opening angle
+ * @return std::array<double, 3>
+ */
+inline auto uniform_cone(double u, double v, double cos_max)
+    -> std::array<double, 3> {
+    const auto d = concentric_disk(u, v);
+    const auto r2 = d[0] * d[0] + d[1] * d[1];
+    const auto z = 1.0 - r2 * (1.0 - cos_max);
+    const auto s = std::sqrt(std::max(0.0, (1.0 - cos_max) * (1.0 + z)));
+    return {d[0] * s, d[1] * s, z};
+}
+
+/**
+ * @brief Batch concentric disk map
+ *
+ * The `warp_disk(uv, num, out)` function maps `num` pairs (u, v), stored
+ * row by row in `uv`, writing 2 doubles per point to `out` (which may be
+ * `uv`). The pairs can come from any 2D source (`Halton`, `Pmj02`, ...).
+ *
+ * @param[in] uv
+ * @param[in] num
+ * @param[out] out
+ */
+inline auto warp_disk(const double *uv, size_t num, double *out) -> void {
+    for (size_t k = 0; k != num; ++k) {
+        const auto d = concentric_disk(uv[2 * k], uv[2 * k + 1]);
+        out[2 * k] = d[0];
+        out[2 * k + 1] = d[1];
+    }
+}
+
+/**
+ * @brief Batch cosine-weighted hemisphere map
+ *
+ * The `warp_cosine_hemisphere(uv, num, out)` function maps `num` pairs
+ * (u, v), writing 3 doubles per point to `out`.
+ *
+ * @param[in] uv
+ * @param[in] num
+ * @param[out] out
+ */
+inline auto warp_cosine_hemisphere(const double *uv, size_t num, double *out)
+    -> void {
+    for (size_t k = 0; k != num; ++k) {
+        const auto d = cosine_hemisphere(uv[2 * k], uv[2 * k + 1]);
+        out[3 * k] = d[0];
+        out[3 * k + 1] = d[1];
+        out[3 * k + 2] = d[2];
+    }
+}
+
+/**
+ * @brief Batch uniform cone map
+ *
+ * The `warp_cone(uv, num, out, cos_max)` function maps `num` pairs (u, v),
+ * writing 3 doubles per point to `out`.
+ *
+ * @param[in] uv
+ * @param[in] num
+ * @param[out] out
+ * @param[in] cos_max cosine of the half opening angle
+ */
+inline auto warp_cone(const double *uv, size_t num, double *out,
+                      double cos_max) -> void {
+    for (size_t k = 0; k != num; ++k) {
+        const auto d = uniform_cone(uv[2 * k], uv[2 * k + 1], cos_max);
+        out[3 * k] = d[0];
+        out[3 * k + 1] = d[1];
+        out[3 * k + 2] = d[2];
+    }
+}
+
+/**
+ * @brief Concentric disk sequence generator
+ *
+ * The `Disk` class maps the `Halton(base0, base1)` sequence onto the unit
+ * disk with `concentric_disk()`.
+ */
+class Disk {
+    Halton halton;
+
+  public:
+    /**
+     * @brief Construct a new Disk object
+     *
+     * @param[in] base0
+     * @param[in] base1
+     */
+    Disk(size_t base0, size_t base1) : halton(base0, base1) {}
+
+    /**
+     * @brief pop
+     *
+     * @return std::array<double, 2>
+     */
+    auto pop() -> std::array<double, 2> {
+        const auto uv = this->halton.pop();
+        return concentric_disk(uv[0], uv[1]);
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function writes the next `num`
+     * points row by row into `out`, which must hold `2 * num` doubles.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        this->halton.fill(out, num);
+        warp_disk(out, num, out);
+    }
+
+    /**
+     * @brief reseed
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void { this->halton.reseed(seed); }
+};
+
+/**
+ * @brief Cone direction sequence generator
+ *
+ * The `Cone` class maps the `Halton(base0, base1)` sequence uniformly to
+ * directions in the cone cos(theta) >= cos_max around +z with
+ * `uniform_cone()`; cos_max = 0 gives the uniform hemisphere.
+ */
+class Cone {
+    Halton halton;
+    double cos_max;
+
+    static constexpr size_t BLOCK = 256;
+
+  public:
+    /**
+     * @brief Construct a new Cone object
+     *
+     * @param[in] base0
+     * @param[in] base1
+     * @param[in] cos_max cosine of the half opening angle
+     */
+    Cone(size_t base0, size_t base1, double cos_max)
+        : halton(base0, base1), cos_max{cos_max} {}
+
+    /**
+     * @brief pop
+     *
+     * @return std::array<double, 3>
+     */
+    auto pop() -> std::array<double, 3> {
+        const auto uv = this->halton.pop();
+        return uniform_cone(uv[0], uv[1], this->cos_max);
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function writes the next `num`
+     * directions row by row into `out`, which must hold `3 * num` doubles.
+     * The (u, v) pairs are generated in small blocks on the stack.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        double uv[2 * BLOCK];
+        for (size_t i = 0; i < num; i += BLOCK) {
+            const auto len = std::min(BLOCK, num - i);
+            this->halton.fill(uv, len);
+            warp_cone(uv, len, out + 3 * i, this->cos_max);
+        }
+    }
+
+    /**
+     * @brief reseed
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void { this->halton.reseed(seed); }
+};
+
+/**
+ * @brief Cosine-weighted hemisphere direction sequence generator
+ *
+ * The `CosineHemisphere` class maps the `Halton(base0, base1)` sequence to
+ * directions of the hemisphere z >= 0 with density cos(theta) / pi, using
+ * `cosine_hemisphere()`.
+ */
+class CosineHemisphere {
+    Halton halton;
+
+    static constexpr size_t BLOCK = 256;
+
+  public:
+    /**
+     * @brief Construct a new CosineHemisphere object
+     *
+     * @param[in] base0
+     * @param[in] base1
+     */
+    CosineHemisphere(size_t base0, size_t base1) : halton(base0, base1) {}
+
+    /**
+     * @brief pop
+     *
+     * @return std::array<double, 3>
+     */
+    auto pop() -> std::array<double, 3> {
+        const auto uv = this->halton.pop();
+        return cosine_hemisphere(uv[0], uv[1]);
+    }
+
+    /**
+     * @brief fill
+     *
+     * The `fill(double *out, size_t num)` function writes the next `num`
+     * directions row by row into `out`, which must hold `3 * num` doubles.
+     *
+     * @param[out] out
+     * @param[in] num
+     */
+    auto fill(double *out, size_t num) -> void {
+        double uv[2 * BLOCK];
+        for (size_t i = 0; i < num; i += BLOCK) {
+            const auto len = std::min(BLOCK, num - i);
+            this->halton.fill(uv, len);
+            warp_cosine_hemisphere(uv, len, out + 3 * i);
+        }
+    }
+
+    /**
+     * @brief reseed
+     *
+     * @param[in] seed
+     */
+    auto reseed(size_t seed) -> void { this->halton.reseed(seed); }
+};
+
+} // namespace lds2
@@ -0,0 +1,87 @@
+#include <lds/alias.hpp>
+
+#include <algorithm> // for min
+
+#include <lds/parallel.hpp> // for parallel_for
+
+namespace lds2 {
+
+namespace {
+
+/**
+ * @brief Vose's alias construction for the len weights at w
+ *
+ * @return double the sum of the weights
+ */
+auto build(const double *w, size_t len, double *prob, uint32_t *alias)
+    -> double {
+    auto sum = 0.0;
+    for (size_t i = 0; i != len; ++i) {
+        assert(w[i] >= 0.0);
+        sum += w[i];
+    }
+    if (sum <= 0.0) { // never selected; keep the table valid
+        for (size_t i = 0; i != len; ++i) {
+            prob[i] = 1.0;
+            alias[i] = uint32_t(i);
+        }
+        return sum;
+    }
+    const auto scale = double(len) / sum;
+    auto small = vector<uint32_t>{};
+    auto large = vector<uint32_t>{};
+    for (size_t i = 0; i != len; ++i) {
+        prob[i] = w[i] * scale;
+        (prob[i] < 1.0 ? small : large).emplace_back(uint32_t(i));
+    }
+    while (!small.empty() && !large.empty()) {
+        const auto s = small.back();
+        small.pop_back();
+        const auto l = large.back();
+        alias[s] = l;
+        prob[l] -= 1.0 - prob[s];
+        if (prob[l] < 1.0) {
+            large.pop_back();
+            small.emplace_back(l);
+        }
+    }
+    // what is left is 1 up to rounding
+    for (const auto &i : large) {
+        prob[i] = 1.0;
+        alias[i] = i;
+    }
+    for (const auto &i : small) {
+        prob[i] = 1.0;
+        alias[i] = i;
+    }
+    return sum;
+}
+
+} // namespace
+
+AliasTable::AliasTable(const double *weights, size_t n, size_t num_threads)
+    : n{n}, prob(n), alias(n), total{0.0} {
+    assert(n >= 1 && (uint64_t(n) >> 32U) == 0U);
+    const auto nblocks = (n + BLOCK - 1) / BLOCK;
+    auto sums = vector<double>(nblocks);
+    parallel_for(
+        0, nblocks,
+        [this, weights, &sums](size_t first, size_t last) {
+            for (auto b = first; b != last; ++b) {
+                const auto lo = b * BLOCK;
+                const auto len = std::min(BLOCK, this->n - lo);
+                sums[b] = build(weights + lo, len, &this->prob[lo],
+                                &this->alias[lo]);
+            }
+        },
+        num_threads, 1);
+    for (const auto &s : sums) {
+        this->total += s;
+    }
+    assert(this->total > 0.0);
+    this->top_prob.resize(nblocks);
+    this->top_alias.resize(nblocks);
+    build(sums.data(), nblocks, this->top_prob.data(), this->top_alias.data());
+}
+
+} // namespace lds2
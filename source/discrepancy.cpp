@@ -0,0 +1,350 @@
+#include <lds/discrepancy.hpp>
+
+#include <algorithm> // for min, max, sort, lower_bound
+#include <cassert>   // for assert
+#include <cmath>     // for abs, pow, sqrt
+#include <numeric>   // for iota
+#include <utility>   // for move
+
+#include <lds/parallel.hpp> // for parallel_for
+
+namespace lds2 {
+
+namespace {
+
+constexpr size_t TILE = 64; // points per tile side
+
+/*
+ * Each kind is a pair kernel folded over the coordinates, K::pair(acc, a, b)
+ * from K::init and closed by K::finish, optionally a per-point term
+ * K::single(x) multiplied over the coordinates, and the closed form
+ * K::value(single, pairs, num, dim) of the squared discrepancy from the
+ * sums over the points and over all ordered pairs.
+ */
+
+struct Star {
+    static constexpr double init = 1.0;
+    static constexpr bool has_single = true;
+    static auto pair(double acc, double a, double b) -> double {
+        return acc * (1.0 - std::max(a, b));
+    }
+    static auto finish(double acc) -> double { return acc; }
+    static auto single(double x) -> double { return (1.0 - x * x) / 2.0; }
+    static auto value(double single, double pairs, size_t num, size_t dim)
+        -> double {
+        const auto n = double(num);
+        return std::pow(3.0, -double(dim)) - 2.0 / n * single +
+               pairs / (n * n);
+    }
+};
+
+struct Centered {
+    static constexpr double init = 1.0;
+    static constexpr bool has_single = true;
+    static auto pair(double acc, double a, double b) -> double {
+        return acc * (1.0 + 0.5 * std::abs(a - 0.5) + 0.5 * std::abs(b - 0.5) -
+                      0.5 * std::abs(a - b));
+    }
+    static auto finish(double acc) -> double { return acc; }
+    static auto single(double x) -> double {
+        const auto a = std::abs(x - 0.5);
+        return 1.0 + 0.5 * a - 0.5 * a * a;
+    }
+    static auto value(double single, double pairs, size_t num, size_t dim)
+        -> double {
+        const auto n = double(num);
+        return std::pow(13.0 / 12.0, double(dim)) - 2.0 / n * single +
+               pairs / (n * n);
+    }
+};
+
+struct WrapAround {
+    static constexpr double init = 1.0;
+    static constexpr bool has_single = false;
+    static auto pair(double acc, double a, double b) -> double {
+        const auto t = std::abs(a - b);
+        return acc * (1.5 - t * (1.0 - t));
+    }
+    static auto finish(double acc) -> double { return acc; }
+    static auto single(double /* x */) -> double { return 1.0; }
+    static auto value(double /* single */, double pairs, size_t num,
+                      size_t dim) -> double {
+        const auto n = double(num);
+        return -std::pow(4.0 / 3.0, double(dim)) + pairs / (n * n);
+    }
+};
+
+struct SphereCap {
+    static constexpr double init = 0.0;
+    static constexpr bool has_single = false;
+    static auto pair(double acc, double a, double b) -> double {
+        return acc + (a - b) * (a - b);
+    }
+    static auto finish(double acc) -> double { return std::sqrt(acc); }
+    static auto single(double /* x */) -> double { return 1.0; }
+    static auto value(double /* single */, double pairs, size_t num,
+                      size_t /* dim */) -> double {
+        const auto n = double(num);
+        return (4.0 / 3.0 - pairs / (n * n)) / 4.0;
+    }
+};
+
+/**
+ * @brief Call fn with the kernel of the given kind
+ */
+template <typename Fn> auto dispatch(DiscrepancyKind kind, Fn &&fn) -> double {
+    switch (kind) {
+    case DiscrepancyKind::L2Star:
+        return fn(Star{});
+    case DiscrepancyKind::Centered:
+        return fn(Centered{});
+    case DiscrepancyKind::WrapAround:
+        return fn(WrapAround{});
+    case DiscrepancyKind::SphereCap:
+        return fn(SphereCap{});
+    }
+    return 0.0;
+}
+
+/**
+ * @brief Pair kernel of two row-major points
+ */
+template <typename K>
+auto pair_term(const double *a, const double *b, size_t dim) -> double {
+    auto acc = K::init;
+    for (size_t k = 0; k != dim; ++k) {
+        acc = K::pair(acc, a[k], b[k]);
+    }
+    return K::finish(acc);
+}
+
+/**
+ * @brief Per-point term of a row-major point
+ */
+template <typename K> auto single_term(const double *a, size_t dim) -> double {
+    auto prod = 1.0;
+    for (size_t k = 0; k != dim; ++k) {
+        prod *= K::single(a[k]);
+    }
+    return prod;
+}
+
+/**
+ * @brief Sum of the pair kernel over all ordered pairs (i, j)
+ *
+ * `xt` holds the points transposed, xt[k * num + i]. The kernel is
+ * symmetric, so only the tiles on and above the diagonal are visited and
+ * the others are counted twice. Tile row t is paired with tile row
+ * tiles - 1 - t to even out the work of a task.
+ */
+template <typename K>
+auto pair_sum(const vector<double> &xt, size_t num, size_t dim,
+              size_t num_threads) -> double {
+    const auto tiles = (num + TILE - 1) / TILE;
+    auto partial = vector<double>(tiles, 0.0);
+    auto do_row = [&](size_t r) {
+        double acc[TILE];
+        const auto i_end = std::min(num, (r + 1) * TILE);
+        auto res = 0.0;
+        for (auto c = r; c != tiles; ++c) {
+            const auto j0 = c * TILE;
+            const auto len = std::min(num, j0 + TILE) - j0;
+            auto tile = 0.0;
+            for (auto i = r * TILE; i != i_end; ++i) {
+                for (size_t j = 0; j != len; ++j) {
+                    acc[j] = K::init;
+                }
+                for (size_t k = 0; k != dim; ++k) {
+                    const auto xi = xt[k * num + i];
+                    const auto *xj = &xt[k * num + j0];
+                    for (size_t j = 0; j != len; ++j) {
+                        acc[j] = K::pair(acc[j], xi, xj[j]);
+                    }
+                }
+                for (size_t j = 0; j != len; ++j) {
+                    tile += K::finish(acc[j]);
+                }
+            }
+            res += c == r ? tile : 2.0 * tile;
+        }
+        partial[r] = res;
+    };
+    parallel_for(
+        0, (tiles + 1) / 2,
+        [&](size_t first, size_t last) {
+            for (auto t = first; t != last; ++t) {
+                do_row(t);
+                if (tiles - 1 - t != t) {
+                    do_row(tiles - 1 - t);
+                }
+            }
+        },
+        num_threads, 1);
+    auto sum = 0.0;
+    for (const auto &p : partial) {
+        sum += p;
+    }
+    return sum;
+}
+
+} // namespace
+
+auto l2_discrepancy(const double *pts, size_t num, size_t dim,
+                    DiscrepancyKind kind, size_t num_threads) -> double {
+    assert(num > 0);
+    assert(kind != DiscrepancyKind::SphereCap || dim == 3);
+    if (kind == DiscrepancyKind::L2Star && dim == 2) {
+        return l2_star_2d(pts, num);
+    }
+    auto xt = vector<double>(num * dim);
+    for (size_t i = 0; i != num; ++i) {
+        for (size_t k = 0; k != dim; ++k) {
+            xt[k * num + i] = pts[i * dim + k];
+        }
+    }
+    const auto res = dispatch(kind, [&](auto kernel) {
+        using K = decltype(kernel);
+        auto single = 0.0;
+        if (K::has_single) {
+            for (size_t i = 0; i != num; ++i) {
+                single += single_term<K>(pts + i * dim, dim);
+            }
+        }
+        return K::value(single, pair_sum<K>(xt, num, dim, num_threads), num,
+                        dim);
+    });
+    return std::sqrt(std::max(res, 0.0));
+}
+
+auto l2_star_2d(const double *pts, size_t num) -> double {
+    assert(num > 0);
+    auto order = vector<size_t>(num);
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::sort(order.begin(), order.end(), [pts](size_t a, size_t b) {
+        return pts[2 * a] < pts[2 * b];
+    });
+    auto ys = vector<double>(num);
+    for (size_t i = 0; i != num; ++i) {
+        ys[i] = pts[2 * i + 1];
+    }
+    std::sort(ys.begin(), ys.end());
+
+    // Fenwick trees over the y ranks: count and sum of (1 - y)
+    auto cnt = vector<double>(num + 1, 0.0);
+    auto sum = vector<double>(num + 1, 0.0);
+    auto single = 0.0; // sum of (1 - x^2)(1 - y^2) / 4
+    auto diag = 0.0;   // pairs (i, i)
+    auto cross = 0.0;  // pairs i < j in x order
+    auto seen = 0.0;   // sum of (1 - y) of the points seen so far
+    for (const auto &i : order) {
+        const auto x = pts[2 * i];
+        const auto y = pts[2 * i + 1];
+        // points seen with y' <= y have ranks up to r
+        const auto r = size_t(std::lower_bound(ys.begin(), ys.end(), y) -
+                              ys.begin()) + 1;
+        auto c = 0.0;
+        auto s = 0.0;
+        for (auto p = r; p != 0; p &= p - 1) {
+            c += cnt[p];
+            s += sum[p];
+        }
+        // max(y', y) is y for the c points below, y' for the others
+        cross += (1.0 - x) * (c * (1.0 - y) + (seen - s));
+        for (auto p = r; p <= num; p += p & (~p + 1)) {
+            cnt[p] += 1.0;
+            sum[p] += 1.0 - y;
+        }
+        seen += 1.0 - y;
+        single += (1.0 - x * x) * (1.0 - y * y) / 4.0;
+        diag += (1.0 - x) * (1.0 - y);
+    }
+    return std::sqrt(
+        std::max(Star::value(single, diag + 2.0 * cross, num, 2), 0.0));
+}
+
+auto write_discrepancy_csv(std::ostream &os, const std::string &name,
+                           const vector<DiscrepancyRecord> &records,
+                           bool header) -> bool {
+    const auto prec = os.precision(17);
+    if (header) {
+        os << "name,n,dim,l2_star,centered,wrap_around\n";
+    }
+    for (const auto &r : records) {
+        os << name << ',' << r.num << ',' << r.dim << ',' << r.l2_star << ','
+           << r.centered << ',' << r.wrap_around << '\n';
+    }
+    os.precision(prec);
+    return bool(os);
+}
+
+DiscrepancyMonitor::DiscrepancyMonitor(size_t dim, DiscrepancyKind kind,
+                                       size_t interval, Callback callback)
+    : dim{dim}, kind{kind}, interval{interval},
+      callback{std::move(callback)}, count{0}, single{0.0}, pairs{0.0},
+      stop{false} {
+    assert(dim > 0 && interval > 0);
+    assert(kind != DiscrepancyKind::SphereCap || dim == 3);
+}
+
+auto DiscrepancyMonitor::add(const double *pts, size_t num,
+                             size_t num_threads) -> size_t {
+    if (this->stop || num == 0) {
+        return 0;
+    }
+    const auto dim = this->dim;
+    const auto first = this->size();
+    this->pts.insert(this->pts.end(), pts, pts + num * dim);
+    // contribution of each new point: its pairs with all earlier points
+    // (twice), with itself, and its own term
+    auto dpairs = vector<double>(num);
+    auto dsingle = vector<double>(num, 0.0);
+    dispatch(this->kind, [&](auto kernel) {
+        using K = decltype(kernel);
+        const auto *all = this->pts.data();
+        parallel_for(
+            0, num,
+            [&](size_t begin, size_t end) {
+                for (auto i = begin; i != end; ++i) {
+                    const auto *x = all + (first + i) * dim;
+                    auto s = 0.0;
+                    for (size_t j = 0; j != first + i; ++j) {
+                        s += pair_term<K>(x, all + j * dim, dim);
+                    }
+                    dpairs[i] = 2.0 * s + pair_term<K>(x, x, dim);
+                    if (K::has_single) {
+                        dsingle[i] = single_term<K>(x, dim);
+                    }
+                }
+            },
+            num_threads, 16);
+        return 0.0;
+    });
+    // accept the points one by one, so the callback sees every multiple
+    // of the interval
+    for (size_t i = 0; i != num; ++i) {
+        this->pairs += dpairs[i];
+        this->single += dsingle[i];
+        const auto n = ++this->count;
+        if (n % this->interval == 0 && this->callback &&
+            !this->callback(n, this->value())) {
+            this->stop = true;
+            this->pts.resize(n * dim);
+            return i + 1;
+        }
+    }
+    return num;
+}
+
+auto DiscrepancyMonitor::value() const -> double {
+    const auto n = this->size();
+    if (n == 0) {
+        return 0.0;
+    }
+    const auto res = dispatch(this->kind, [&](auto kernel) {
+        using K = decltype(kernel);
+        return K::value(this->single, this->pairs, n, this->dim);
+    });
+    return std::sqrt(std::max(res, 0.0));
+}
+
+} // namespace lds2
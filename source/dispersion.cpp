@@ -0,0 +1,235 @@
+#include <lds/dispersion.hpp>
+
+#include <algorithm> // for max, min, swap_ranges
+#include <cassert>   // for assert
+#include <cmath>     // for sqrt
+#include <limits>    // for numeric_limits
+#include <numeric>   // for iota
+#include <thread>    // for thread
+#include <utility>   // for pair, swap
+
+#include <lds/parallel.hpp> // for parallel_for
+
+namespace lds2 {
+
+namespace {
+
+constexpr size_t BLOCK = 4096; // queries per task
+
+inline auto dist2(const double *a, const double *b, size_t dim) -> double {
+    auto res = 0.0;
+    for (size_t k = 0; k != dim; ++k) {
+        res += (a[k] - b[k]) * (a[k] - b[k]);
+    }
+    return res;
+}
+
+/**
+ * @brief Run fn(i) for i in [0, num) in blocks, in parallel
+ *
+ * One partial result per block, combined in block order.
+ */
+template <typename Fn, typename Op>
+auto block_reduce(size_t num, double init, Fn fn, Op op, size_t num_threads)
+    -> double {
+    const auto blocks = (num + BLOCK - 1) / BLOCK;
+    auto partial = vector<double>(blocks, init);
+    parallel_for(
+        0, blocks,
+        [&](size_t first, size_t last) {
+            for (auto b = first; b != last; ++b) {
+                auto res = init;
+                const auto end = std::min(num, (b + 1) * BLOCK);
+                for (auto i = b * BLOCK; i != end; ++i) {
+                    res = op(res, fn(i));
+                }
+                partial[b] = res;
+            }
+        },
+        num_threads, 1);
+    auto res = init;
+    for (const auto &p : partial) {
+        res = op(res, p);
+    }
+    return res;
+}
+
+} // namespace
+
+auto KdTree::swap_rows(size_t i, size_t j) -> void {
+    std::swap_ranges(&this->pts[i * this->dim], &this->pts[(i + 1) * this->dim],
+                     &this->pts[j * this->dim]);
+    std::swap(this->index[i], this->index[j]);
+}
+
+auto KdTree::split(size_t lo, size_t hi) -> size_t {
+    const auto dim = this->dim;
+    const auto *x = this->pts.data();
+    // axis of largest spread
+    auto vmin = vector<double>(x + lo * dim, x + (lo + 1) * dim);
+    auto vmax = vmin;
+    for (auto i = lo + 1; i != hi; ++i) {
+        for (size_t k = 0; k != dim; ++k) {
+            vmin[k] = std::min(vmin[k], x[i * dim + k]);
+            vmax[k] = std::max(vmax[k], x[i * dim + k]);
+        }
+    }
+    auto a = size_t(0);
+    for (size_t k = 1; k != dim; ++k) {
+        if (vmax[k] - vmin[k] > vmax[a] - vmin[a]) {
+            a = k;
+        }
+    }
+    // quickselect of the median row along a, swapping whole rows so the
+    // ranges stay contiguous in memory
+    const auto mid = lo + (hi - lo) / 2;
+    auto l = lo;
+    auto r = hi - 1;
+    while (l < r) {
+        const auto pivot = x[(l + (r - l) / 2) * dim + a];
+        auto i = l;
+        auto j = r;
+        while (i <= j) {
+            while (x[i * dim + a] < pivot) {
+                ++i;
+            }
+            while (pivot < x[j * dim + a]) {
+                --j;
+            }
+            if (i <= j) {
+                this->swap_rows(i++, j--);
+            }
+        }
+        if (mid <= j) {
+            r = j;
+        } else if (mid >= i) {
+            l = i;
+        } else {
+            break;
+        }
+    }
+    this->axis[mid] = (unsigned char)a;
+    return mid;
+}
+
+auto KdTree::build(size_t lo, size_t hi) -> void {
+    if (hi - lo <= LEAF) {
+        return;
+    }
+    const auto mid = this->split(lo, hi);
+    this->build(lo, mid);
+    this->build(mid + 1, hi);
+}
+
+KdTree::KdTree(const double *pts, size_t num, size_t dim, size_t num_threads)
+    : dim{dim}, pts(pts, pts + num * dim), index(num), axis(num, 0) {
+    assert(dim > 0 && dim < 256);
+    std::iota(this->index.begin(), this->index.end(), size_t(0));
+    if (num_threads == 0) {
+        num_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    // split the top levels here, until there are enough subtrees to share
+    auto ranges = vector<std::pair<size_t, size_t>>{{0, num}};
+    while (ranges.size() < 4 * num_threads) {
+        auto next = vector<std::pair<size_t, size_t>>{};
+        for (const auto &r : ranges) {
+            if (r.second - r.first <= LEAF) {
+                next.emplace_back(r);
+                continue;
+            }
+            const auto mid = this->split(r.first, r.second);
+            next.emplace_back(r.first, mid);
+            next.emplace_back(mid + 1, r.second);
+        }
+        if (next.size() == ranges.size()) {
+            break;
+        }
+        ranges.swap(next);
+    }
+    parallel_for(
+        0, ranges.size(),
+        [&](size_t first, size_t last) {
+            for (auto r = first; r != last; ++r) {
+                this->build(ranges[r].first, ranges[r].second);
+            }
+        },
+        num_threads, 1);
+}
+
+auto KdTree::search(size_t lo, size_t hi, const double *q, size_t exclude,
+                    double &best, size_t &best_i) const -> void {
+    const auto dim = this->dim;
+    if (hi - lo <= LEAF) {
+        for (auto i = lo; i != hi; ++i) {
+            const auto d = dist2(q, &this->pts[i * dim], dim);
+            if (d < best && this->index[i] != exclude) {
+                best = d;
+                best_i = i;
+            }
+        }
+        return;
+    }
+    const auto mid = lo + (hi - lo) / 2;
+    const auto *p = &this->pts[mid * dim];
+    const auto d = dist2(q, p, dim);
+    if (d < best && this->index[mid] != exclude) {
+        best = d;
+        best_i = mid;
+    }
+    const auto diff = q[this->axis[mid]] - p[this->axis[mid]];
+    if (diff < 0.0) {
+        this->search(lo, mid, q, exclude, best, best_i);
+        if (diff * diff < best) {
+            this->search(mid + 1, hi, q, exclude, best, best_i);
+        }
+    } else {
+        this->search(mid + 1, hi, q, exclude, best, best_i);
+        if (diff * diff < best) {
+            this->search(lo, mid, q, exclude, best, best_i);
+        }
+    }
+}
+
+auto KdTree::nearest(const double *q, double &dist2, size_t exclude) const
+    -> size_t {
+    dist2 = std::numeric_limits<double>::infinity();
+    auto best_i = this->size();
+    this->search(0, this->size(), q, exclude, dist2, best_i);
+    return best_i < this->size() ? this->index[best_i] : this->size();
+}
+
+auto KdTree::min_distance(size_t num_threads) const -> double {
+    assert(this->size() >= 2);
+    const auto res = block_reduce(
+        this->size(), std::numeric_limits<double>::infinity(),
+        [this](size_t i) {
+            auto d = 0.0;
+            this->nearest(&this->pts[i * this->dim], d, this->index[i]);
+            return d;
+        },
+        [](double a, double b) { return std::min(a, b); }, num_threads);
+    return std::sqrt(res);
+}
+
+auto min_distance(const double *pts, size_t num, size_t dim,
+                  size_t num_threads) -> double {
+    return KdTree(pts, num, dim, num_threads).min_distance(num_threads);
+}
+
+auto covering_radius(const double *pts, size_t num, size_t dim,
+                     const double *probes, size_t num_probes,
+                     size_t num_threads) -> double {
+    assert(num > 0);
+    const auto tree = KdTree(pts, num, dim, num_threads);
+    const auto res = block_reduce(
+        num_probes, 0.0,
+        [&tree, probes, dim](size_t i) {
+            auto d = 0.0;
+            tree.nearest(probes + i * dim, d);
+            return d;
+        },
+        [](double a, double b) { return std::max(a, b); }, num_threads);
+    return std::sqrt(res);
+}
+
+} // namespace lds2
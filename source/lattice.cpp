@@ -0,0 +1,330 @@
+#include <lds/lattice.hpp>
+
+#include <algorithm> // for min, max, fill
+#include <complex>   // for complex, polar, conj
+#include <fstream>   // for ifstream, ofstream
+#include <limits>    // for numeric_limits
+#include <utility>   // for swap
+
+#include <lds/lds.hpp> // for M_PI, TWO_PI
+
+namespace lds2 {
+
+namespace {
+
+using cplx = std::complex<double>;
+
+/**
+ * @brief Korobov kernel of smoothness 2, omega(x) = 2 pi^2 B_2(x)
+ *
+ * Symmetric about 1/2, i.e. omega(x) = omega(1 - x).
+ */
+inline auto omega(double x) -> double {
+    return 2.0 * M_PI * M_PI * (x * x - x + 1.0 / 6.0);
+}
+
+/**
+ * @brief Complex product without the NaN/inf recovery of operator*
+ */
+inline auto mul(const cplx &a, const cplx &b) -> cplx {
+    return {a.real() * b.real() - a.imag() * b.imag(),
+            a.real() * b.imag() + a.imag() * b.real()};
+}
+
+/**
+ * @brief Radix-2 FFT with twiddle factors precomputed up to a maximal length
+ */
+class Fft {
+    vector<cplx> roots; // exp(-2 pi i k / maxlen), k < maxlen / 2
+
+  public:
+    explicit Fft(size_t maxlen) : roots(maxlen / 2) {
+        const auto ang = -TWO_PI / double(maxlen);
+        for (size_t k = 0; k != roots.size(); ++k) {
+            roots[k] = std::polar(1.0, ang * double(k));
+        }
+    }
+
+    /**
+     * @brief In-place transform; the length must be a power of two
+     */
+    auto operator()(vector<cplx> &a, bool inverse) const -> void {
+        const auto len = a.size();
+        for (size_t i = 1, j = 0; i < len; ++i) {
+            auto bit = len >> 1U;
+            for (; (j & bit) != 0U; bit >>= 1U) {
+                j ^= bit;
+            }
+            j ^= bit;
+            if (i < j) {
+                std::swap(a[i], a[j]);
+            }
+        }
+        for (size_t half = 1; half < len; half <<= 1U) {
+            const auto stride = this->roots.size() / half;
+            for (size_t i = 0; i < len; i += 2 * half) {
+                auto *lo = &a[i];
+                auto *hi = &a[i + half];
+                for (size_t k = 0; k != half; ++k) {
+                    const auto &w = this->roots[k * stride];
+                    const auto tw = inverse ? std::conj(w) : w;
+                    const auto v = mul(hi[k], tw);
+                    hi[k] = lo[k] - v;
+                    lo[k] += v;
+                }
+            }
+        }
+    }
+};
+
+auto pow_mod(uint64_t b, uint64_t e, uint64_t n) -> uint64_t {
+    auto r = uint64_t(1) % n;
+    for (b %= n; e != 0U; e >>= 1U) {
+        if ((e & 1U) != 0U) {
+            r = r * b % n;
+        }
+        b = b * b % n;
+    }
+    return r;
+}
+
+/**
+ * @brief Smallest primitive root of the prime n
+ */
+auto primitive_root(uint64_t n) -> uint64_t {
+    auto factors = vector<uint64_t>{};
+    auto r = n - 1;
+    for (uint64_t f = 2; f * f <= r; ++f) {
+        if (r % f == 0) {
+            factors.emplace_back(f);
+            while (r % f == 0) {
+                r /= f;
+            }
+        }
+    }
+    if (r > 1) {
+        factors.emplace_back(r);
+    }
+    for (uint64_t g = 2;; ++g) {
+        auto ok = true;
+        for (const auto &f : factors) {
+            if (pow_mod(g, (n - 1) / f, n) == 1) {
+                ok = false;
+                break;
+            }
+        }
+        if (ok) {
+            return g;
+        }
+    }
+}
+
+/**
+ * @brief Multiply the running products p(k) by the factor of component z
+ */
+auto update_products(vector<double> &p, uint64_t n, uint64_t z, double gamma)
+    -> void {
+    auto kz = uint64_t(0);
+    for (auto &pk : p) {
+        pk *= 1.0 + gamma * omega(double(kz) / double(n));
+        kz += z;
+        kz = kz >= n ? kz - n : kz;
+    }
+}
+
+} // namespace
+
+auto cbc_prime(size_t n, const vector<double> &gamma) -> vector<size_t> {
+    assert(n >= 3 && (uint64_t(n) >> 32U) == 0U);
+    const auto nn = uint64_t(n);
+    const auto g = primitive_root(nn);
+    // omega and the products are symmetric, so the circulant of length n - 1
+    // indexed by powers of g folds onto one of length (n - 1) / 2
+    const auto half = size_t(nn - 1) / 2;
+    auto gpow = vector<uint64_t>(nn - 1);
+    gpow[0] = 1;
+    for (size_t t = 1; t != gpow.size(); ++t) {
+        gpow[t] = gpow[t - 1] * g % nn;
+    }
+    // cyclic convolution of length half by a zero-padded power-of-two FFT
+    auto len = size_t(1);
+    while (len < 2 * half) {
+        len <<= 1U;
+    }
+    const auto fft = Fft(len);
+    auto wf = vector<cplx>(len);
+    for (size_t t = 0; t != 2 * half; ++t) {
+        wf[t] = omega(double(gpow[t % half]) / double(nn));
+    }
+    fft(wf, false);
+
+    auto p = vector<double>(n, 1.0);
+    auto z = vector<size_t>{};
+    auto x = vector<cplx>(len);
+    for (const auto &gam : gamma) {
+        if (z.empty()) { // all units are equivalent as first component
+            z.emplace_back(1);
+            update_products(p, nn, 1, gam);
+            continue;
+        }
+        // x[b] = p(g^-b); c[a] = sum_b x[b] omega(g^(a-b) / n)
+        std::fill(x.begin(), x.end(), 0.0);
+        for (size_t b = 0; b != half; ++b) {
+            x[b] = p[gpow[(nn - 1 - b) % (nn - 1)]];
+        }
+        fft(x, false);
+        for (size_t i = 0; i != len; ++i) {
+            x[i] = mul(x[i], wf[i]);
+        }
+        fft(x, true);
+        auto best = size_t(0);
+        for (size_t a = 1; a != half; ++a) {
+            if (x[a + half].real() < x[best + half].real()) {
+                best = a;
+            }
+        }
+        z.emplace_back(size_t(gpow[best]));
+        update_products(p, nn, gpow[best], gam);
+    }
+    return z;
+}
+
+auto cbc_embedded(size_t m, const vector<double> &gamma, size_t m_min)
+    -> vector<size_t> {
+    assert(m <= 32);
+    const auto nn = uint64_t(1) << m;
+    if (m < 3) {
+        return vector<size_t>(gamma.size(), 1);
+    }
+    // pw[n][t] = 5^t mod 2^n, and the FFT of omega(5^t / 2^n), for n >= 3;
+    // every odd residue mod 2^n is +-5^t with t < 2^(n-2)
+    const auto fft = Fft(size_t(1) << (m - 2));
+    auto pw = vector<vector<uint64_t>>(m + 1);
+    auto wf = vector<vector<cplx>>(m + 1);
+    for (size_t n = 3; n <= m; ++n) {
+        const auto len = size_t(1) << (n - 2);
+        const auto mask = (uint64_t(1) << n) - 1;
+        pw[n].resize(len);
+        wf[n].resize(len);
+        pw[n][0] = 1;
+        for (size_t t = 1; t != len; ++t) {
+            pw[n][t] = pw[n][t - 1] * 5 & mask;
+        }
+        for (size_t t = 0; t != len; ++t) {
+            wf[n][t] = omega(double(pw[n][t]) / double(mask + 1));
+        }
+        fft(wf[n], false);
+    }
+    const auto lo = std::max<size_t>(m_min, 3);
+    const auto num = size_t(1) << (m - 2);
+
+    auto p = vector<double>(size_t(nn), 1.0);
+    auto z = vector<size_t>{};
+    auto conv = vector<vector<double>>(m + 1);
+    auto base = vector<double>(m + 1);
+    auto x = vector<cplx>{};
+    for (const auto &gam : gamma) {
+        if (z.empty()) { // all units are equivalent as first component
+            z.emplace_back(1);
+            update_products(p, nn, 1, gam);
+            continue;
+        }
+        // the points k = 2^(m-n) u, u odd, are those added at level n; for
+        // n <= 2 their kernel values do not depend on z
+        base[0] = p[0] * (1.0 + gam * omega(0.0));
+        for (size_t n = 1; n <= m; ++n) {
+            const auto step = size_t(1) << (m - n);
+            auto s = 0.0;
+            for (auto k = step; k < size_t(nn); k += 2 * step) {
+                s += p[k];
+            }
+            base[n] = s;
+        }
+        base[1] *= 1.0 + gam * omega(0.5);
+        base[2] *= 1.0 + gam * omega(0.25);
+        for (size_t n = 3; n <= m; ++n) {
+            const auto len = size_t(1) << (n - 2);
+            const auto step = size_t(1) << (m - n);
+            const auto mask = (uint64_t(1) << n) - 1;
+            x.assign(len, 0.0);
+            for (size_t b = 0; b != len; ++b) {
+                const auto u = size_t(pw[n][(len - b) % len]); // 5^-b
+                const auto v = size_t((mask + 1 - u) & mask);     // -5^-b
+                x[b] = p[u * step] + p[v * step];
+            }
+            fft(x, false);
+            for (size_t i = 0; i != len; ++i) {
+                x[i] = mul(x[i], wf[n][i]);
+            }
+            fft(x, true);
+            conv[n].resize(len);
+            for (size_t a = 0; a != len; ++a) {
+                conv[n][a] = base[n] + gam * x[a].real() / double(len);
+            }
+        }
+        // e_l^2(a) = -1 + 2^-l sum_{n <= l} T_n(a mod 2^(n-2)); first the
+        // best error of each level on its own
+        const auto fixed = base[0] + base[1] + base[2];
+        auto best = vector<double>(m + 1, std::numeric_limits<double>::max());
+        auto acc = vector<double>{fixed};
+        for (size_t n = 3; n <= m; ++n) {
+            const auto len = size_t(1) << (n - 2);
+            const auto prev = acc.size();
+            acc.resize(len);
+            for (auto a = len; a-- != 0;) {
+                acc[a] = acc[a % prev] + conv[n][a];
+            }
+            if (n >= lo) {
+                const auto scale = 1.0 / double(uint64_t(1) << n);
+                for (size_t a = 0; a != len; ++a) {
+                    best[n] = std::min(best[n], acc[a] * scale - 1.0);
+                }
+            }
+        }
+        auto best_a = size_t(0);
+        auto best_ratio = std::numeric_limits<double>::max();
+        for (size_t a = 0; a != num; ++a) {
+            auto sum = fixed;
+            auto ratio = 0.0;
+            for (size_t n = 3; n <= m; ++n) {
+                sum += conv[n][a & ((size_t(1) << (n - 2)) - 1)];
+                if (n >= lo) {
+                    const auto e2 = sum / double(uint64_t(1) << n) - 1.0;
+                    ratio = std::max(ratio, e2 / best[n]);
+                }
+            }
+            if (ratio < best_ratio) {
+                best_ratio = ratio;
+                best_a = a;
+            }
+        }
+        z.emplace_back(size_t(pw[m][best_a]));
+        update_products(p, nn, pw[m][best_a], gam);
+    }
+    return z;
+}
+
+auto save_generating_vector(const std::string &path, size_t n,
+                            const vector<size_t> &z) -> bool {
+    auto ofs = std::ofstream(path);
+    ofs << n << '\n';
+    for (const auto &zj : z) {
+        ofs << zj << '\n';
+    }
+    return bool(ofs);
+}
+
+auto load_generating_vector(const std::string &path, size_t &n,
+                            vector<size_t> &z) -> bool {
+    auto ifs = std::ifstream(path);
+    if (!(ifs >> n)) {
+        return false;
+    }
+    z.clear();
+    for (size_t zj; ifs >> zj;) {
+        z.emplace_back(zj);
+    }
+    return ifs.eof();
+}
+
+} // namespace lds2
@@ -0,0 +1,108 @@
+#include <lds/niederreiter.hpp>
+
+namespace lds2 {
+
+namespace {
+
+/**
+ * @brief Degree of a nonzero polynomial over GF(2), bit i being x^i
+ */
+auto degree(uint64_t p) -> size_t {
+    auto d = size_t(0);
+    while ((p >> (d + 1)) != 0U) {
+        ++d;
+    }
+    return d;
+}
+
+/**
+ * @brief Remainder of p modulo q over GF(2)
+ */
+auto poly_mod(uint64_t p, uint64_t q) -> uint64_t {
+    const auto dq = degree(q);
+    while (p != 0U && degree(p) >= dq) {
+        p ^= q << (degree(p) - dq);
+    }
+    return p;
+}
+
+/**
+ * @brief The first `num` irreducible polynomials over GF(2) in increasing
+ * order, by trial division
+ */
+auto irreducible_polys(size_t num) -> vector<uint64_t> {
+    auto res = vector<uint64_t>{};
+    for (uint64_t p = 2; res.size() != num; ++p) {
+        auto ok = true;
+        for (const auto &q : res) {
+            if (2 * degree(q) > degree(p)) {
+                break;
+            }
+            if (poly_mod(p, q) == 0U) {
+                ok = false;
+                break;
+            }
+        }
+        if (ok) {
+            res.emplace_back(p);
+        }
+    }
+    return res;
+}
+
+} // namespace
+
+Niederreiter::Niederreiter(size_t dim)
+    : count{0}, dim{dim}, tval{0}, cols(NIED_BITS * dim), state(dim, 0U) {
+    assert(dim >= 1);
+    const auto polys = irreducible_polys(dim);
+    for (size_t j = 0; j != dim; ++j) {
+        // coefficients of the polynomial p and of the running product b = p^i
+        const auto e = degree(polys[j]);
+        this->tval += e - 1;
+        const auto maxv = NIED_BITS + e;
+        auto px = vector<uint8_t>(e + 1);
+        for (size_t k = 0; k <= e; ++k) {
+            px[k] = uint8_t((polys[j] >> k) & 1U);
+        }
+        auto pb = vector<uint8_t>{1};
+        auto v = vector<uint8_t>(maxv + 1);
+        auto u = size_t(0);
+        for (size_t c = 0; c != NIED_BITS; ++c) {
+            if (u == 0) {
+                // b <- b p, then v is a solution of the linear recurrence
+                // with characteristic polynomial b, starting 0...0 1 1...1
+                const auto bigm = pb.size() - 1;
+                auto prod = vector<uint8_t>(pb.size() + e);
+                for (size_t a = 0; a != pb.size(); ++a) {
+                    for (size_t k = 0; k <= e; ++k) {
+                        prod[a + k] ^= uint8_t(pb[a] & px[k]);
+                    }
+                }
+                pb.swap(prod);
+                const auto m = pb.size() - 1;
+                for (size_t r = 0; r != m; ++r) {
+                    v[r] = uint8_t(r >= bigm ? 1 : 0);
+                }
+                for (size_t r = 0; r + m <= maxv; ++r) {
+                    auto sum = uint8_t(0);
+                    for (size_t k = 0; k != m; ++k) {
+                        sum ^= uint8_t(pb[k] & v[r + k]);
+                    }
+                    v[r + m] = sum;
+                }
+            }
+            // row c of the matrix is v[u], v[u + 1], ...; entry (c, r) is
+            // output digit c of input bit r
+            for (size_t r = 0; r != NIED_BITS; ++r) {
+                if (v[r + u] != 0U) {
+                    this->cols[r * dim + j] |= uint64_t(1)
+                                               << (NIED_BITS - 1 - c);
+                }
+            }
+            u = u + 1 == e ? 0 : u + 1;
+        }
+    }
+}
+
+} // namespace lds2
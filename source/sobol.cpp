@@ -0,0 +1,42 @@
+#include <lds/sobol.hpp>
+
+namespace lds2 {
+
+extern const uint16_t SOBOL_POLY[SOBOL_MAX_DIM - 1];
+extern const uint16_t SOBOL_MINIT[(SOBOL_MAX_DIM - 1) * 15];
+
+Sobol::Sobol(size_t dim)
+    : count{0}, dim{dim}, dirs(SOBOL_BITS * dim), state(dim, 0U) {
+    assert(dim >= 1 && dim <= SOBOL_MAX_DIM);
+    auto m = vector<uint32_t>(SOBOL_BITS);
+    for (size_t j = 0; j != dim; ++j) {
+        if (j == 0) {
+            std::fill(m.begin(), m.end(), 1U); // Van der Corput in base 2
+        } else {
+            const auto poly = size_t(SOBOL_POLY[j - 1]);
+            auto degree = size_t(0);
+            while ((poly >> (degree + 1)) != 0U) {
+                ++degree;
+            }
+            for (size_t i = 0; i != degree; ++i) {
+                m[i] = SOBOL_MINIT[(j - 1) * 15 + i];
+            }
+            // m_i = 2 a_1 m_{i-1} ^ ... ^ 2^{s-1} a_{s-1} m_{i-s+1}
+            //       ^ 2^s m_{i-s} ^ m_{i-s}
+            for (size_t i = degree; i != SOBOL_BITS; ++i) {
+                auto mi = m[i - degree] ^ (m[i - degree] << degree);
+                for (size_t k = 1; k != degree; ++k) {
+                    if (((poly >> (degree - k)) & 1U) != 0U) {
+                        mi ^= m[i - k] << k;
+                    }
+                }
+                m[i] = mi;
+            }
+        }
+        for (size_t i = 0; i != SOBOL_BITS; ++i) {
+            this->dirs[i * dim + j] = m[i] << (SOBOL_BITS - 1 - i);
+        }
+    }
+}
+
+} // namespace lds2
@@ -0,0 +1,45 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <lds/alias.hpp> // for AliasTable
+#include <vector>
+
+TEST_CASE("AliasTable") {
+    const auto table = lds2::AliasTable({1.0, 2.0, 3.0, 0.0, 4.0});
+    CHECK_EQ(table.sum(), doctest::Approx(10.0));
+    auto counts = std::vector<int>(5, 0);
+    for (size_t k = 0; k != 10000; ++k) {
+        auto rest = 0.0;
+        counts[table.sample((double(k) + 0.5) / 10000.0, rest)] += 1;
+        CHECK_GE(rest, 0.0);
+        CHECK_LT(rest, 1.0);
+    }
+    CHECK_EQ(counts[0], 1000);
+    CHECK_EQ(counts[1], 2000);
+    CHECK_EQ(counts[2], 3000);
+    CHECK_EQ(counts[3], 0);
+    CHECK_EQ(counts[4], 4000);
+}
+
+TEST_CASE("AliasTable blocks") {
+    // several blocks, with one block of zero weight
+    const auto n = 3 * lds2::AliasTable::BLOCK + 100;
+    auto w = std::vector<double>(n);
+    for (size_t i = 0; i != n; ++i) {
+        w[i] = i / lds2::AliasTable::BLOCK == 1 ? 0.0 : double(i % 3);
+    }
+    const auto table = lds2::AliasTable(w, 4);
+    auto total = 0.0;
+    for (const auto &x : w) {
+        total += x;
+    }
+    CHECK_EQ(table.sum(), doctest::Approx(total));
+    auto counts = std::vector<double>(n, 0.0);
+    const auto num = size_t(1000000);
+    for (size_t k = 0; k != num; ++k) {
+        counts[table.sample((double(k) + 0.5) / double(num))] += 1.0;
+    }
+    for (size_t i : {0, 1, 2, 5000, 12290, 12387}) {
+        CHECK_EQ(counts[i] / double(num) * total,
+                 doctest::Approx(w[i]).epsilon(0.01));
+    }
+}
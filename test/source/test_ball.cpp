@@ -0,0 +1,67 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <algorithm>     // for max
+#include <cmath>         // for abs, pow, sqrt
+#include <lds/ball.hpp>  // for BallN, CubeShellN
+#include <lds/lds_n.hpp> // for PRIME_TABLE
+#include <vector>
+
+TEST_CASE("BallN") {
+    for (size_t dim = 2; dim != 7; ++dim) {
+        const auto base = std::vector<size_t>(
+            lds2::PRIME_TABLE, lds2::PRIME_TABLE + lds2::BallN::num_bases(dim));
+        auto bgen = lds2::BallN(dim, base);
+        auto buf = std::vector<double>(dim * 2000);
+        bgen.fill(buf.data(), 2000);
+        // the inner ball of radius 2^(-1 / dim) holds half the volume
+        const auto half = std::pow(0.5, 1.0 / double(dim));
+        auto inner = 0;
+        for (size_t k = 0; k != 2000; ++k) {
+            auto norm2 = 0.0;
+            for (size_t j = 0; j != dim; ++j) {
+                norm2 += buf[dim * k + j] * buf[dim * k + j];
+            }
+            CHECK_LE(norm2, 1.0 + 1e-12);
+            inner += std::sqrt(norm2) < half ? 1 : 0;
+        }
+        CHECK_EQ(inner, doctest::Approx(1000).epsilon(0.01));
+        bgen.reseed(0);
+        const auto res = bgen.pop();
+        CHECK_EQ(res[0], doctest::Approx(buf[0]));
+    }
+}
+
+TEST_CASE("BallN (shell)") {
+    auto bgen = lds2::BallN(3, {2, 3, 5}, 0.5, 2.0);
+    for (size_t k = 0; k != 1000; ++k) {
+        const auto p = bgen.pop();
+        const auto r = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        CHECK_GE(r, 0.5 - 1e-12);
+        CHECK_LE(r, 2.0 + 1e-12);
+    }
+}
+
+TEST_CASE("CubeShellN") {
+    auto cgen = lds2::CubeShellN(3, {2, 3, 5, 7}, 0.5);
+    CHECK_EQ(cgen.dimension(), 3);
+    auto buf = std::vector<double>(3 * 2000);
+    cgen.fill(buf.data(), 2000);
+    auto positive = 0;
+    for (size_t k = 0; k != 2000; ++k) {
+        const auto *p = &buf[3 * k];
+        auto inf = 0.0;
+        for (size_t j = 0; j != 3; ++j) {
+            inf = std::max(inf, std::abs(p[j]));
+        }
+        CHECK_GE(inf, 0.5 - 1e-12);
+        CHECK_LE(inf, 1.0 + 1e-12);
+        positive += p[0] > 0.0 ? 1 : 0;
+    }
+    CHECK_EQ(positive, doctest::Approx(1000).epsilon(0.01));
+    // a fill() across several blocks matches pop() point by point
+    cgen.reseed(0);
+    for (size_t k = 0; k != 2000; ++k) {
+        const auto p = cgen.pop();
+        CHECK_EQ(p[2], buf[3 * k + 2]);
+    }
+}
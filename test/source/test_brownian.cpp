@@ -0,0 +1,49 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <algorithm>        // for min
+#include <cmath>            // for sqrt
+#include <lds/brownian.hpp> // for BrownianBridge
+#include <lds/lds_n.hpp>    // for HaltonN
+#include <vector>
+
+TEST_CASE("BrownianBridge covariance") {
+    // the paths of the unit vectors e_i are the columns of a square root
+    // of the covariance matrix min(t_l, t_m)
+    const auto times = std::vector<double>{0.1, 0.25, 0.5, 0.6, 0.9, 1.5};
+    const auto bb = lds2::BrownianBridge(times);
+    const auto n = times.size();
+    auto cols = std::vector<double>(n * n);
+    for (size_t i = 0; i != n; ++i) {
+        auto z = std::vector<double>(n, 0.0);
+        z[i] = 1.0;
+        bb.transform(z.data(), &cols[i * n]);
+    }
+    for (size_t l = 0; l != n; ++l) {
+        for (size_t m = 0; m != n; ++m) {
+            auto c = 0.0;
+            for (size_t i = 0; i != n; ++i) {
+                c += cols[i * n + l] * cols[i * n + m];
+            }
+            CHECK_EQ(c, doctest::Approx(std::min(times[l], times[m])));
+        }
+    }
+    // z_0 alone gives the straight line to W(T)
+    CHECK_EQ(cols[2], doctest::Approx(0.5 / std::sqrt(1.5)));
+}
+
+TEST_CASE("BrownianBridge batch") {
+    const auto bb = lds2::BrownianBridge(8, 1.0);
+    auto hgen = lds2::HaltonN({2, 3, 5, 7, 11, 13, 17, 19});
+    auto out = std::vector<double>(8 * 100);
+    bb.fill(hgen, 100, out.data(), 100);
+    hgen.reseed(0);
+    auto z = std::vector<double>(8 * 100);
+    lds2::fill_normal(hgen, z.data(), 100);
+    for (size_t p : {0, 63, 64, 99}) {
+        auto path = std::vector<double>(8);
+        bb.transform(&z[p * 8], path.data());
+        for (size_t l = 0; l != 8; ++l) {
+            CHECK_EQ(out[l * 100 + p], doctest::Approx(path[l]));
+        }
+    }
+}
@@ -0,0 +1,143 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <algorithm>           // for max
+#include <cmath>               // for sqrt
+#include <lds/discrepancy.hpp> // for l2_discrepancy, l2_star_2d, ...
+#include <lds/lds.hpp>         // for Halton, Sphere
+#include <lds/lds_n.hpp>       // for HaltonN
+#include <sstream>             // for ostringstream
+#include <string>              // for string
+#include <vector>
+
+// Warnock's formula, pair by pair
+static auto l2_star_naive(const std::vector<double> &pts, size_t num,
+                          size_t dim) -> double {
+    auto single = 0.0;
+    auto pairs = 0.0;
+    for (size_t i = 0; i != num; ++i) {
+        auto p = 1.0;
+        for (size_t k = 0; k != dim; ++k) {
+            p *= (1.0 - pts[i * dim + k] * pts[i * dim + k]) / 2.0;
+        }
+        single += p;
+        for (size_t j = 0; j != num; ++j) {
+            auto q = 1.0;
+            for (size_t k = 0; k != dim; ++k) {
+                q *= 1.0 - std::max(pts[i * dim + k], pts[j * dim + k]);
+            }
+            pairs += q;
+        }
+    }
+    const auto n = double(num);
+    auto res = 1.0;
+    for (size_t k = 0; k != dim; ++k) {
+        res /= 3.0;
+    }
+    return std::sqrt(res - 2.0 / n * single + pairs / (n * n));
+}
+
+TEST_CASE("l2_discrepancy (single point)") {
+    const auto x = std::vector<double>{0.5};
+    using lds2::DiscrepancyKind;
+    CHECK_EQ(lds2::l2_discrepancy(x.data(), 1, 1, DiscrepancyKind::L2Star),
+             doctest::Approx(std::sqrt(1.0 / 12.0)));
+    CHECK_EQ(lds2::l2_discrepancy(x.data(), 1, 1, DiscrepancyKind::Centered),
+             doctest::Approx(std::sqrt(1.0 / 12.0)));
+    CHECK_EQ(
+        lds2::l2_discrepancy(x.data(), 1, 1, DiscrepancyKind::WrapAround),
+        doctest::Approx(std::sqrt(1.0 / 6.0)));
+}
+
+TEST_CASE("l2_discrepancy") {
+    auto hgen = lds2::HaltonN({2, 3, 5});
+    auto pts = std::vector<double>(3 * 300);
+    hgen.fill(pts.data(), 300);
+    const auto d1 = lds2::l2_discrepancy(pts.data(), 300, 3,
+                                         lds2::DiscrepancyKind::L2Star, 1);
+    const auto d4 = lds2::l2_discrepancy(pts.data(), 300, 3,
+                                         lds2::DiscrepancyKind::L2Star, 4);
+    CHECK_EQ(d1, doctest::Approx(l2_star_naive(pts, 300, 3)));
+    CHECK_EQ(d1, d4); // deterministic reduction
+}
+
+TEST_CASE("l2_star_2d") {
+    auto hgen = lds2::Halton(2, 3);
+    auto pts = std::vector<double>(2 * 500);
+    hgen.fill(pts.data(), 500);
+    pts[2] = pts[0]; // ties in x and y
+    pts[5] = pts[1];
+    CHECK_EQ(lds2::l2_star_2d(pts.data(), 500),
+             doctest::Approx(l2_star_naive(pts, 500, 2)));
+}
+
+TEST_CASE("write_discrepancy_csv") {
+    auto hgen = lds2::Halton(2, 3);
+    const auto records = lds2::measure_discrepancy(hgen, {10, 100});
+    CHECK_EQ(records.size(), 2);
+    CHECK_EQ(records[1].num, 100);
+    CHECK_LT(records[1].l2_star, records[0].l2_star);
+    auto os = std::ostringstream{};
+    CHECK(lds2::write_discrepancy_csv(os, "halton", records));
+    const auto csv = os.str();
+    CHECK_EQ(csv.substr(0, csv.find('\n')),
+             "name,n,dim,l2_star,centered,wrap_around");
+    CHECK_EQ(csv.find("halton,100,2,"), csv.rfind('\n', csv.size() - 2) + 1);
+}
+
+TEST_CASE("DiscrepancyMonitor") {
+    auto hgen = lds2::HaltonN({2, 3, 5});
+    auto pts = std::vector<double>(3 * 1000);
+    hgen.fill(pts.data(), 1000);
+    auto calls = std::vector<double>{};
+    auto monitor = lds2::DiscrepancyMonitor(
+        3, lds2::DiscrepancyKind::Centered, 100, [&calls](size_t n, double d) {
+            CHECK_EQ(n, 100 * (calls.size() + 1));
+            calls.push_back(d);
+            return true;
+        });
+    CHECK_EQ(monitor.add(pts.data(), 150, 2), 150);
+    CHECK_EQ(monitor.add(pts.data() + 3 * 150, 850, 2), 850);
+    CHECK_EQ(calls.size(), 10);
+    CHECK_EQ(monitor.value(),
+             doctest::Approx(lds2::l2_discrepancy(
+                 pts.data(), 1000, 3, lds2::DiscrepancyKind::Centered)));
+    const auto d500 = lds2::l2_discrepancy(pts.data(), 500, 3,
+                                           lds2::DiscrepancyKind::Centered);
+    CHECK_EQ(calls[4], doctest::Approx(d500));
+}
+
+TEST_CASE("DiscrepancyMonitor (sphere cap)") {
+    auto monitor = lds2::DiscrepancyMonitor(3, lds2::DiscrepancyKind::SphereCap,
+                                            1);
+    const double poles[] = {0.0, 0.0, 1.0, 0.0, 0.0, -1.0};
+    monitor.add(poles, 1);
+    CHECK_EQ(monitor.value(), doctest::Approx(std::sqrt(1.0 / 3.0)));
+    monitor.add(poles + 3, 1);
+    CHECK_EQ(monitor.value(), doctest::Approx(std::sqrt(1.0 / 12.0)));
+    auto sgen = lds2::Sphere(2, 3);
+    auto pts = std::vector<double>(3 * 400);
+    for (size_t k = 0; k != 400; ++k) {
+        const auto p = sgen.pop();
+        pts[3 * k] = p[0];
+        pts[3 * k + 1] = p[1];
+        pts[3 * k + 2] = p[2];
+    }
+    CHECK_LT(lds2::l2_discrepancy(pts.data(), 400, 3,
+                                  lds2::DiscrepancyKind::SphereCap),
+             0.02);
+}
+
+TEST_CASE("fill_until") {
+    // stop as soon as the L2 star discrepancy is below 0.01
+    auto monitor = lds2::DiscrepancyMonitor(
+        3, lds2::DiscrepancyKind::L2Star, 10,
+        [](size_t, double d) { return d >= 0.01; });
+    auto hgen = lds2::HaltonN({2, 3, 5});
+    auto pts = std::vector<double>(3 * 5000);
+    const auto num = lds2::fill_until(hgen, monitor, pts.data(), 5000);
+    CHECK(monitor.stopped());
+    CHECK_EQ(num, monitor.size());
+    CHECK_EQ(num % 10, 0);
+    CHECK_LT(monitor.value(), 0.01);
+    CHECK_GE(lds2::l2_discrepancy(pts.data(), num - 10, 3), 0.01);
+}
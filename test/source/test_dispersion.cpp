@@ -0,0 +1,70 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <cmath>              // for sqrt
+#include <lds/dispersion.hpp> // for KdTree, min_distance, covering_radius
+#include <lds/lds.hpp>        // for Halton, Sphere
+#include <lds/lds_n.hpp>      // for HaltonN
+#include <vector>
+
+TEST_CASE("KdTree") {
+    auto hgen = lds2::HaltonN({2, 3, 5});
+    auto pts = std::vector<double>(3 * 2000);
+    hgen.fill(pts.data(), 2000);
+    const auto tree = lds2::KdTree(pts.data(), 2000, 3, 2);
+    CHECK_EQ(tree.size(), 2000);
+    auto qgen = lds2::HaltonN({7, 11, 13});
+    for (size_t t = 0; t != 100; ++t) {
+        const auto q = qgen.pop();
+        auto d2 = 0.0;
+        const auto i = tree.nearest(q.data(), d2);
+        auto best = 1e9;
+        for (size_t j = 0; j != 2000; ++j) {
+            auto e = 0.0;
+            for (size_t k = 0; k != 3; ++k) {
+                e += (q[k] - pts[3 * j + k]) * (q[k] - pts[3 * j + k]);
+            }
+            best = e < best ? e : best;
+        }
+        CHECK_EQ(d2, doctest::Approx(best));
+        auto e = 0.0;
+        for (size_t k = 0; k != 3; ++k) {
+            e += (q[k] - pts[3 * i + k]) * (q[k] - pts[3 * i + k]);
+        }
+        CHECK_EQ(e, doctest::Approx(best));
+    }
+}
+
+TEST_CASE("min_distance") {
+    // a 10 x 10 grid with one point moved closer to its neighbour
+    auto pts = std::vector<double>{};
+    for (size_t i = 0; i != 10; ++i) {
+        for (size_t j = 0; j != 10; ++j) {
+            pts.push_back(0.05 + 0.1 * double(i));
+            pts.push_back(0.05 + 0.1 * double(j));
+        }
+    }
+    CHECK_EQ(lds2::min_distance(pts.data(), 100, 2, 2),
+             doctest::Approx(0.1));
+    pts[2 * 37] += 0.03;
+    CHECK_EQ(lds2::min_distance(pts.data(), 100, 2, 2),
+             doctest::Approx(0.07));
+}
+
+TEST_CASE("covering_radius") {
+    // octahedron: the largest empty caps are centered on the faces
+    const double octa[] = {1.0,  0.0, 0.0, -1.0, 0.0, 0.0,
+                           0.0,  1.0, 0.0, 0.0,  -1.0, 0.0,
+                           0.0,  0.0, 1.0, 0.0,  0.0, -1.0};
+    auto sgen = lds2::Sphere(2, 3);
+    auto probes = std::vector<double>(3 * 20000);
+    for (size_t k = 0; k != 20000; ++k) {
+        const auto p = sgen.pop();
+        probes[3 * k] = p[0];
+        probes[3 * k + 1] = p[1];
+        probes[3 * k + 2] = p[2];
+    }
+    const auto r = lds2::covering_radius(octa, 6, 3, probes.data(), 20000, 2);
+    const auto exact = std::sqrt(2.0 - 2.0 / std::sqrt(3.0));
+    CHECK_LE(r, exact + 1e-12);
+    CHECK_EQ(r, doctest::Approx(exact).epsilon(0.005));
+}
@@ -0,0 +1,32 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <lds/faure.hpp> // for Faure
+#include <vector>
+
+TEST_CASE("Faure") {
+    auto fgen = lds2::Faure(2);
+    CHECK_EQ(fgen.get_base(), 2);
+    const auto res = fgen.pop();
+    CHECK_EQ(res[0], doctest::Approx(0.5));
+    CHECK_EQ(res[1], doctest::Approx(0.5));
+    const auto res2 = fgen.pop();
+    CHECK_EQ(res2[0], doctest::Approx(0.25));
+    CHECK_EQ(res2[1], doctest::Approx(0.75));
+    const auto res3 = fgen.pop();
+    CHECK_EQ(res3[0], doctest::Approx(0.75));
+    CHECK_EQ(res3[1], doctest::Approx(0.25));
+}
+
+TEST_CASE("Faure fill and reseed") {
+    auto fgen = lds2::Faure(300);
+    CHECK_EQ(fgen.get_base(), 307);
+    auto buf = std::vector<double>(400 * 300);
+    fgen.fill(buf.data(), 400);
+    fgen.reseed(350);
+    const auto res = fgen.pop();
+    for (size_t j = 0; j != 300; ++j) {
+        CHECK_EQ(res[j], buf[350 * 300 + j]);
+    }
+    // the first coordinate is the Van der Corput sequence in base 307
+    CHECK_EQ(res[0], doctest::Approx(lds2::vdc(351, 307)));
+}
@@ -0,0 +1,48 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <cmath>             // for sqrt
+#include <lds/fibonacci.hpp> // for SphericalFibonacci
+#include <vector>
+
+TEST_CASE("SphericalFibonacci") {
+    auto sfgen = lds2::SphericalFibonacci(100);
+    const auto res = sfgen.pop();
+    CHECK_EQ(res[2], doctest::Approx(1.0 - 3.0 / 100.0));
+    const auto r2 = res[0] * res[0] + res[1] * res[1] + res[2] * res[2];
+    CHECK_EQ(r2, doctest::Approx(1.0));
+    auto buf = std::vector<double>(3 * 100);
+    sfgen.fill(buf.data());
+    CHECK_EQ(buf[3], doctest::Approx(res[0]));
+    CHECK_EQ(buf[4], doctest::Approx(res[1]));
+}
+
+TEST_CASE("SphericalFibonacci nearest") {
+    const auto sfgen = lds2::SphericalFibonacci(1000);
+    auto pts = std::vector<double>(3 * 1000);
+    sfgen.fill(pts.data());
+    auto idx = std::vector<size_t>(1000);
+    sfgen.nearest(pts.data(), 1000, idx.data());
+    for (size_t i = 0; i != 1000; ++i) {
+        CHECK_EQ(idx[i], i);
+    }
+    // a direction near point 500 and the poles
+    auto p = sfgen.at(500);
+    p[0] += 0.01;
+    const auto r = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+    p = {p[0] / r, p[1] / r, p[2] / r};
+    auto best = size_t(0);
+    auto dmin = 5.0;
+    for (size_t i = 0; i != 1000; ++i) {
+        auto d = 0.0;
+        for (size_t j = 0; j != 3; ++j) {
+            d += (pts[3 * i + j] - p[j]) * (pts[3 * i + j] - p[j]);
+        }
+        if (d < dmin) {
+            dmin = d;
+            best = i;
+        }
+    }
+    CHECK_EQ(sfgen.nearest(p), best);
+    CHECK_EQ(sfgen.nearest({0.0, 0.0, 1.0}), 0);
+    CHECK_EQ(sfgen.nearest({0.0, 0.0, -1.0}), 999);
+}
@@ -0,0 +1,45 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <lds/halton_perm.hpp> // for ScrambledHaltonN, faure_permutation
+#include <lds/lds_n.hpp>       // for PRIME_TABLE
+#include <cmath> // for lround
+#include <vector>
+
+TEST_CASE("faure_permutation") {
+    const auto perm = lds2::faure_permutation(5);
+    const auto expected = std::vector<uint32_t>{0, 3, 2, 1, 4};
+    CHECK(perm == expected);
+}
+
+TEST_CASE("ScrambledHaltonN") {
+    const std::vector<size_t> base = {2, 3, 5, 7};
+    auto hgen = lds2::ScrambledHaltonN(base);
+    const auto res = hgen.pop();
+    CHECK_EQ(res[0], doctest::Approx(0.5));
+    CHECK_EQ(res[2], doctest::Approx(0.6));
+    CHECK_EQ(hgen.dimension(), 4);
+    const auto second = hgen.pop();
+    auto buf = std::vector<double>(4 * 2);
+    hgen.reseed(0);
+    hgen.fill(buf.data(), 2);
+    for (size_t j = 0; j != 4; ++j) {
+        CHECK_EQ(buf[j], res[j]);
+        CHECK_EQ(buf[4 + j], second[j]);
+    }
+}
+
+TEST_CASE("ScrambledHaltonN random") {
+    const auto b = lds2::PRIME_TABLE[99];
+    auto hgen = lds2::ScrambledHaltonN({b}, 1234U);
+    // the first b points still hit each interval of width 1/b once
+    auto strata = std::vector<int>(b, 0);
+    hgen.reseed(0);
+    strata[0] += 1; // point 0 is the origin
+    for (size_t i = 1; i != b; ++i) {
+        // single-digit points are exactly perm[i] / b
+        strata[size_t(std::lround(hgen.pop()[0] * double(b)))] += 1;
+    }
+    for (auto n : strata) {
+        CHECK_EQ(n, 1);
+    }
+}
@@ -0,0 +1,39 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <lds/hammersley.hpp> // for Hammersley, Hammersley2
+#include <vector>
+
+TEST_CASE("Hammersley") {
+    auto hgen = lds2::Hammersley(10, {2, 3});
+    const auto res = hgen.pop();
+    CHECK_EQ(res[0], doctest::Approx(0.1));
+    CHECK_EQ(res[1], doctest::Approx(0.5));
+    CHECK_EQ(res[2], doctest::Approx(1.0 / 3.0));
+}
+
+TEST_CASE("Hammersley fill") {
+    const size_t n = 10000;
+    auto hgen = lds2::Hammersley(n, {2, 3});
+    auto buf = std::vector<double>(3 * n);
+    hgen.fill(buf.data(), n, 4);
+    for (const auto k : {size_t(0), size_t(1234), n - 1}) {
+        const auto res = hgen.at(k);
+        CHECK_EQ(buf[k], res[0]);
+        CHECK_EQ(buf[n + k], res[1]);
+        CHECK_EQ(buf[2 * n + k], res[2]);
+    }
+}
+
+TEST_CASE("Hammersley2") {
+    const size_t n = 8192;
+    auto hgen = lds2::Hammersley2(n);
+    auto ham = lds2::Hammersley(n, {2});
+    auto x = std::vector<double>(n);
+    auto y = std::vector<double>(n);
+    hgen.fill(x.data(), y.data(), 4);
+    for (const auto k : {size_t(3), size_t(4097), n - 1}) {
+        CHECK_EQ(x[k], doctest::Approx(ham.at(k)[0]));
+        CHECK_EQ(y[k], doctest::Approx(ham.at(k)[1]));
+    }
+    CHECK_EQ(hgen.pop()[1], doctest::Approx(0.5));
+}
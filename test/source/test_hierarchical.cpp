@@ -0,0 +1,39 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <lds/hierarchical.hpp> // for Hierarchical2D
+#include <lds/lds.hpp>          // for Halton
+#include <vector>
+
+TEST_CASE("Hierarchical2D (constant density is the identity)") {
+    // 3 x 5 is padded to 8 x 8 internally
+    const auto warp = lds2::Hierarchical2D(std::vector<double>(15, 2.0), 3, 5);
+    CHECK_EQ(warp.pdf(0.3, 0.7), doctest::Approx(1.0));
+    const auto p = warp.warp(0.3, 0.7);
+    CHECK_EQ(p[0], doctest::Approx(0.3));
+    CHECK_EQ(p[1], doctest::Approx(0.7));
+    const auto q = warp.warp(0.95, 0.05);
+    CHECK_EQ(q[0], doctest::Approx(0.95));
+    CHECK_EQ(q[1], doctest::Approx(0.05));
+}
+
+TEST_CASE("Hierarchical2D") {
+    // row-major, density[y * width + x]
+    const auto density = std::vector<double>{1.0, 0.0, 0.0, //
+                                             0.0, 0.0, 3.0};
+    const auto warp = lds2::Hierarchical2D(density, 3, 2);
+    CHECK_EQ(warp.pdf(0.1, 0.2), doctest::Approx(1.5));
+    CHECK_EQ(warp.pdf(0.9, 0.9), doctest::Approx(4.5));
+    CHECK_EQ(warp.pdf(0.5, 0.5), doctest::Approx(0.0));
+
+    auto hgen = lds2::Halton(2, 3);
+    auto pts = std::vector<double>(2 * 4000);
+    warp.fill(hgen, pts.data(), 4000, 2);
+    auto low = 0;
+    for (size_t k = 0; k != 4000; ++k) {
+        const auto x = pts[2 * k];
+        const auto y = pts[2 * k + 1];
+        CHECK_GT(warp.pdf(x, y), 0.0);
+        low += y < 0.5 ? 1 : 0;
+    }
+    CHECK_EQ(low, doctest::Approx(1000).epsilon(0.01));
+}
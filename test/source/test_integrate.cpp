@@ -0,0 +1,145 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <cmath>             // for abs, exp, sqrt
+#include <lds/integrate.hpp> // for integrate, integrate_adaptive, ...
+
+TEST_CASE("CompensatedSum") {
+    auto acc = lds2::CompensatedSum{};
+    acc.add(1.0);
+    acc.add(1e100);
+    acc.add(1.0);
+    acc.add(-1e100);
+    CHECK_EQ(acc.value(), 2.0);
+}
+
+TEST_CASE("integrate") {
+    // product of 2 x_k over [0, 1)^5, exact value 1
+    auto f = [](const double *x, size_t stride, size_t num, double *y) {
+        for (size_t i = 0; i != num; ++i) {
+            y[i] = 1.0;
+        }
+        for (size_t k = 0; k != 5; ++k) {
+            for (size_t i = 0; i != num; ++i) {
+                y[i] *= 2.0 * x[k * stride + i];
+            }
+        }
+    };
+    auto opts = lds2::IntegrateOptions{};
+    opts.num_threads = 1;
+    const auto r1 = lds2::integrate(f, 5, 10000, opts);
+    CHECK_EQ(r1.value, doctest::Approx(1.0).epsilon(0.01));
+    CHECK_LT(r1.std_error, 0.01);
+    CHECK_LT(std::abs(r1.value - 1.0), 5.0 * r1.std_error);
+    CHECK_EQ(r1.num_points, 10000);
+    CHECK_EQ(r1.evaluations, 10000 * 16);
+    CHECK(!r1.converged);
+    opts.num_threads = 3;
+    const auto r3 = lds2::integrate(f, 5, 10000, opts);
+    CHECK_EQ(r1.value, r3.value); // deterministic reduction
+    CHECK_EQ(r1.std_error, r3.std_error);
+}
+
+TEST_CASE("integrate (early stop)") {
+    // Gaussian bump, exact value (sqrt(pi) erf(1) / 2)^2
+    auto f = [](const double *x, size_t stride, size_t num, double *y) {
+        for (size_t i = 0; i != num; ++i) {
+            y[i] = std::exp(-x[i] * x[i] - x[stride + i] * x[stride + i]);
+        }
+    };
+    auto opts = lds2::IntegrateOptions{};
+    opts.abs_tol = 1e-5;
+    opts.replicates = 8;
+    const auto res = lds2::integrate(f, 2, 1U << 20U, opts);
+    CHECK(res.converged);
+    CHECK_LT(res.num_points, 1U << 20U);
+    CHECK_EQ(res.value, doctest::Approx(0.5577462853510336).epsilon(1e-4));
+}
+
+TEST_CASE("integrate_adaptive") {
+    // narrow Gaussian peak of mass 1 inside [0, 1)^2
+    auto f = [](const double *x, size_t stride, size_t num, double *y) {
+        const auto s2 = 0.005 * 0.005;
+        for (size_t i = 0; i != num; ++i) {
+            const auto a = x[i] - 0.3;
+            const auto b = x[stride + i] - 0.6;
+            y[i] = std::exp(-(a * a + b * b) / (2.0 * s2)) /
+                   (2.0 * 3.141592653589793 * s2);
+        }
+    };
+    auto opts = lds2::AdaptiveOptions{};
+    opts.points_per_box = 256;
+    opts.rel_tol = 1e-3;
+    opts.num_threads = 1;
+    const auto r1 = lds2::integrate_adaptive(f, 2, opts);
+    CHECK(r1.converged);
+    CHECK_GT(r1.num_boxes, 1);
+    CHECK_EQ(r1.value, doctest::Approx(1.0).epsilon(5e-3));
+    opts.num_threads = 3;
+    const auto r3 = lds2::integrate_adaptive(f, 2, opts);
+    CHECK_EQ(r1.value, r3.value); // deterministic partition and reduction
+    CHECK_EQ(r1.evaluations, r3.evaluations);
+
+    // far fewer evaluations than the plain rule for the same tolerance
+    auto plain = lds2::IntegrateOptions{};
+    plain.replicates = 8;
+    plain.rel_tol = 1e-3;
+    const auto p = lds2::integrate(f, 2, 1U << 22U, plain);
+    CHECK_LT(10 * r1.evaluations, p.evaluations);
+}
+
+TEST_CASE("integrate_adaptive (centred ridge)") {
+    // ridge along x1 through the centre of the cube, of mass 1: the halves
+    // of the cube along every axis have the same spread
+    auto f = [](const double *x, size_t stride, size_t num, double *y) {
+        const auto s2 = 0.01 * 0.01;
+        for (size_t i = 0; i != num; ++i) {
+            const auto t = x[stride + i] - 0.5;
+            y[i] = std::exp(-t * t / (2.0 * s2)) /
+                   std::sqrt(2.0 * 3.141592653589793 * s2);
+        }
+    };
+    auto opts = lds2::AdaptiveOptions{};
+    opts.points_per_box = 256;
+    opts.rel_tol = 1e-3;
+    opts.seed = 19;
+    const auto res = lds2::integrate_adaptive(f, 3, opts);
+    CHECK(res.converged);
+    CHECK_LT(res.evaluations, 400000);
+
+    // the reported error is calibrated over seeds
+    auto z2 = 0.0;
+    for (uint32_t seed = 0; seed != 20; ++seed) {
+        opts.seed = seed;
+        const auto r = lds2::integrate_adaptive(f, 3, opts);
+        CHECK_GT(r.std_error, 0.0);
+        const auto z = (r.value - 1.0) / r.std_error;
+        z2 += z * z;
+    }
+    CHECK_LT(std::sqrt(z2 / 20.0), 1.6);
+}
+
+TEST_CASE("integrate_adaptive (small rounds and budget)") {
+    auto f = [](const double *x, size_t stride, size_t num, double *y) {
+        for (size_t i = 0; i != num; ++i) {
+            const auto a = x[i] - 0.3;
+            const auto b = x[stride + i] - 0.6;
+            y[i] = std::exp(-(a * a + b * b) / (2.0 * 0.05 * 0.05));
+        }
+    };
+    auto opts = lds2::AdaptiveOptions{};
+    opts.points_per_box = 64;
+    opts.boxes_per_round = 1;
+    opts.rel_tol = 1e-3;
+    const auto res = lds2::integrate_adaptive(f, 2, opts);
+    CHECK(res.converged);
+    CHECK_GT(res.num_boxes, 1);
+    const auto exact = 2.0 * 3.141592653589793 * 0.05 * 0.05;
+    CHECK_EQ(res.value, doctest::Approx(exact).epsilon(5e-3));
+
+    // a budget of the first box alone stops right after it
+    opts.max_evaluations = 64 * 8;
+    const auto one = lds2::integrate_adaptive(f, 2, opts);
+    CHECK_EQ(one.evaluations, 64 * 8);
+    CHECK_EQ(one.num_boxes, 1);
+    CHECK(!one.converged);
+}
@@ -0,0 +1,37 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <lds/kronecker.hpp> // for Kronecker, RdSequence
+#include <vector>
+
+TEST_CASE("golden_ratio") {
+    CHECK_EQ(lds2::golden_ratio(1), doctest::Approx(1.6180339887));
+    CHECK_EQ(lds2::golden_ratio(2), doctest::Approx(1.3247179572));
+}
+
+TEST_CASE("Kronecker") {
+    auto kgen = lds2::Kronecker({0.6180339887, 0.25});
+    const auto res = kgen.pop();
+    CHECK_EQ(res[0], doctest::Approx(0.6180339887));
+    const auto res2 = kgen.pop();
+    CHECK_EQ(res2[0], doctest::Approx(0.2360679775));
+    CHECK_EQ(res2[1], doctest::Approx(0.5));
+}
+
+TEST_CASE("RdSequence at and reseed") {
+    auto rgen = lds2::RdSequence(5);
+    rgen.reseed(1000000000);
+    auto buf = std::vector<double>(3 * 5);
+    rgen.fill(buf.data(), 3);
+    const auto res = rgen.at(1000000003);
+    for (size_t j = 0; j != 5; ++j) {
+        CHECK_EQ(res[j], buf[2 * 5 + j]); // bit-exact, no drift
+    }
+}
+
+TEST_CASE("Kronecker stays below 1") {
+    // 3 * alpha is just below 2^64 in fixed point
+    auto kgen = lds2::Kronecker({1.0 / 3.0});
+    for (auto i = 0; i != 3; ++i) {
+        CHECK_LT(kgen.pop()[0], 1.0);
+    }
+}
@@ -0,0 +1,49 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <cstdio>            // for remove
+#include <lds/lattice.hpp>   // for Lattice, LatticeSeq, cbc_embedded
+#include <vector>
+
+TEST_CASE("Lattice") {
+    auto lgen = lds2::Lattice({1, 3}, 5);
+    const auto res = lgen.pop();
+    CHECK_EQ(res[0], doctest::Approx(0.2));
+    CHECK_EQ(res[1], doctest::Approx(0.6));
+    const auto res2 = lgen.pop();
+    CHECK_EQ(res2[1], doctest::Approx(0.2));
+    CHECK_EQ(lgen.at(4)[1], doctest::Approx(0.4));
+}
+
+TEST_CASE("LatticeSeq") {
+    auto lgen = lds2::LatticeSeq({1, 5});
+    auto lat = lds2::Lattice({1, 5}, 8);
+    // the first 8 points are those of the lattice with 8 points, reordered
+    lgen.reseed(0);
+    for (size_t i = 1; i != 8; ++i) {
+        const auto res = lgen.pop();
+        const auto k = size_t(res[0] * 8.0);
+        CHECK_EQ(res[1], doctest::Approx(lat.at(k)[1]));
+    }
+}
+
+TEST_CASE("cbc") {
+    const auto gamma = std::vector<double>{1.0, 0.5, 0.25};
+    const auto z = lds2::cbc_prime(101, gamma);
+    REQUIRE_EQ(z.size(), 3);
+    for (const auto &zj : z) {
+        CHECK_GE(zj, 1);
+        CHECK_LT(zj, 101);
+    }
+    const auto ze = lds2::cbc_embedded(8, gamma);
+    REQUIRE_EQ(ze.size(), 3);
+    for (const auto &zj : ze) {
+        CHECK_EQ(zj % 2, 1);
+    }
+    CHECK(lds2::save_generating_vector("lattice_test.txt", 256, ze));
+    auto n = size_t(0);
+    auto z2 = std::vector<size_t>{};
+    CHECK(lds2::load_generating_vector("lattice_test.txt", n, z2));
+    CHECK_EQ(n, 256);
+    CHECK(z2 == ze);
+    std::remove("lattice_test.txt");
+}
@@ -1,6 +1,6 @@
 #include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
 
-#include <lds/lds_n.hpp> // for cylin_n, halton_n, sphere3, sphere_n
+#include <lds/lds_n.hpp> // for HaltonN, TorusN, Circle
 #include <vector>
 
 TEST_CASE("HaltonN") {
@@ -9,3 +9,24 @@ TEST_CASE("HaltonN") {
     const auto res = hgen.pop();
     CHECK_EQ(res[0], doctest::Approx(0.5));
 }
+
+TEST_CASE("TorusN") {
+    auto tgen = lds2::TorusN({2, 3});
+    CHECK_EQ(tgen.dimension(), 4);
+    const auto res = tgen.pop();
+    CHECK_EQ(res[0], doctest::Approx(-1.0)); // theta_0 = pi
+    CHECK_EQ(res[1], doctest::Approx(0.0));
+    auto cgen = lds2::Circle(3);
+    const auto c = cgen.pop();
+    CHECK_EQ(res[2], doctest::Approx(c[1]));
+    CHECK_EQ(res[3], doctest::Approx(c[0]));
+    auto buf = std::vector<double>(4 * 100);
+    tgen.reseed(0);
+    tgen.fill(buf.data(), 100);
+    CHECK_EQ(buf[0], doctest::Approx(res[0]));
+    for (size_t i = 0; i != 200; ++i) {
+        const auto x = buf[2 * i];
+        const auto y = buf[2 * i + 1];
+        CHECK_EQ(x * x + y * y, doctest::Approx(1.0));
+    }
+}
@@ -0,0 +1,38 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <cstdint>       // for uint32_t
+#include <lds/lds_n.hpp> // for HaltonN
+#include <lds/mesh.hpp>  // for MeshSampler
+#include <vector>
+
+TEST_CASE("MeshSampler") {
+    // unit square at z = 0 (two triangles) and a triangle of area 2 at z = 1
+    const auto vertices = std::vector<double>{
+        0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 1.0, 0.0, 0.0, 1.0, 0.0,
+        0.0, 0.0, 1.0, 2.0, 0.0, 1.0, 0.0, 2.0, 1.0};
+    const auto indices = std::vector<uint32_t>{0, 1, 2, 0, 2, 3, 4, 5, 6};
+    const auto sampler =
+        lds2::MeshSampler(vertices.data(), indices.data(), 3, 2);
+    CHECK_EQ(sampler.area(), doctest::Approx(3.0));
+    auto hgen = lds2::HaltonN({2, 3, 5});
+    auto pts = std::vector<double>(3 * 3000);
+    auto tri = std::vector<uint32_t>(3000);
+    sampler.fill(hgen, pts.data(), 3000, tri.data());
+    auto counts = std::vector<int>(3, 0);
+    for (size_t k = 0; k != 3000; ++k) {
+        const auto *p = &pts[3 * k];
+        counts[tri[k]] += 1;
+        if (tri[k] == 2) {
+            CHECK_EQ(p[2], doctest::Approx(1.0));
+            CHECK_LE(p[0] + p[1], 2.0 + 1e-12);
+        } else {
+            CHECK_EQ(p[2], doctest::Approx(0.0));
+            CHECK_LE(p[0], 1.0);
+            CHECK_LE(p[1], 1.0);
+        }
+        CHECK_GE(p[0], 0.0);
+        CHECK_GE(p[1], 0.0);
+    }
+    CHECK_EQ(counts[2], doctest::Approx(2000).epsilon(0.01));
+    CHECK_EQ(counts[0], doctest::Approx(500).epsilon(0.02));
+}
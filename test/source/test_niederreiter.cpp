@@ -0,0 +1,43 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <lds/niederreiter.hpp> // for Niederreiter
+#include <vector>
+
+TEST_CASE("Niederreiter") {
+    auto ngen = lds2::Niederreiter(3);
+    CHECK_EQ(ngen.t_value(), 1);
+    const auto res = ngen.pop();
+    CHECK_EQ(res[0], doctest::Approx(0.5));
+    CHECK_EQ(res[1], doctest::Approx(0.5));
+    CHECK_EQ(res[2], doctest::Approx(0.75));
+    const auto res2 = ngen.pop();
+    CHECK_EQ(res2[0], doctest::Approx(0.75));
+}
+
+TEST_CASE("Niederreiter fill and reseed") {
+    auto ngen = lds2::Niederreiter(100);
+    auto buf = std::vector<double>(8 * 100);
+    ngen.fill(buf.data(), 8);
+    ngen.reseed(5);
+    const auto res = ngen.pop();
+    for (size_t j = 0; j != 100; ++j) {
+        CHECK_EQ(res[j], doctest::Approx(buf[5 * 100 + j]));
+    }
+}
+
+TEST_CASE("Niederreiter stratification") {
+    // the first two dimensions form a (0, 2)-sequence: points 0..15 put
+    // exactly one point into each cell of the 4 x 4 grid
+    auto ngen = lds2::Niederreiter(2);
+    auto buf = std::vector<double>(16 * 2, 0.0);
+    ngen.fill(buf.data() + 2, 15);
+    auto cells = std::vector<int>(16, 0);
+    for (size_t i = 0; i != 16; ++i) {
+        const auto x = size_t(buf[2 * i] * 4.0);
+        const auto y = size_t(buf[2 * i + 1] * 4.0);
+        cells[x * 4 + y] += 1;
+    }
+    for (auto n : cells) {
+        CHECK_EQ(n, 1);
+    }
+}
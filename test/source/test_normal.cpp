@@ -0,0 +1,38 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <lds/lds_n.hpp>  // for HaltonN
+#include <lds/normal.hpp> // for inv_norm_cdf, fill_normal
+#include <lds/sobol.hpp>  // for Sobol
+#include <vector>
+
+TEST_CASE("inv_norm_cdf") {
+    CHECK_EQ(lds2::inv_norm_cdf(0.5), doctest::Approx(0.0));
+    CHECK_EQ(lds2::inv_norm_cdf(0.975), doctest::Approx(1.959963984540054));
+    CHECK_EQ(lds2::inv_norm_cdf(0.025), doctest::Approx(-1.959963984540054));
+    CHECK_EQ(lds2::inv_norm_cdf(1e-10), doctest::Approx(-6.361340902404056));
+    // the endpoints map to finite values
+    CHECK_EQ(lds2::inv_norm_cdf(0.0), doctest::Approx(-8.209536151601386));
+    CHECK_EQ(lds2::inv_norm_cdf(1.0), doctest::Approx(8.209536151601386));
+}
+
+TEST_CASE("fill_normal") {
+    auto hgen = lds2::HaltonN({2, 3, 5});
+    auto buf = std::vector<double>(1000 * 3);
+    lds2::fill_normal(hgen, buf.data(), 1000);
+    hgen.reseed(0);
+    const auto res = hgen.pop();
+    for (size_t j = 0; j != 3; ++j) {
+        CHECK_EQ(buf[j], doctest::Approx(lds2::inv_norm_cdf(res[j])));
+    }
+    auto sgen = lds2::Sobol(2);
+    auto buf2 = std::vector<double>(1023 * 2);
+    lds2::fill_normal(sgen, buf2.data(), 1023);
+    auto mean = 0.0;
+    auto var = 0.0;
+    for (const auto &x : buf2) {
+        mean += x;
+        var += x * x;
+    }
+    CHECK_EQ(mean / 2046.0, doctest::Approx(0.0).epsilon(1e-3));
+    CHECK_EQ(var / 2046.0, doctest::Approx(1.0).epsilon(0.02));
+}
@@ -0,0 +1,41 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <cmath>            // for sqrt
+#include <lds/lds.hpp>      // for Halton
+#include <lds/lds_n.hpp>    // for HaltonN
+#include <lds/normal.hpp>   // for inv_norm_cdf
+#include <lds/pipeline.hpp> // for make_pipeline, Affine, Gaussian
+#include <vector>
+
+TEST_CASE("Pipeline") {
+    auto pipe = lds2::make_pipeline(
+        lds2::HaltonN({2, 3, 5}), lds2::Affine({-1.0, 0.0}, {1.0, 10.0}),
+        lds2::Gaussian(2, 3),
+        lds2::make_map(1, 2, [](double x) { return x * x; }));
+    CHECK_EQ(pipe.dimension(), 3);
+    auto buf = std::vector<double>(5000 * 3);
+    pipe.fill(buf.data(), 5000);
+    auto hgen = lds2::HaltonN({2, 3, 5});
+    for (size_t k = 0; k != 5000; ++k) {
+        const auto res = hgen.pop();
+        CHECK_EQ(buf[3 * k], doctest::Approx(2.0 * res[0] - 1.0));
+        CHECK_EQ(buf[3 * k + 1], doctest::Approx(100.0 * res[1] * res[1]));
+        CHECK_EQ(buf[3 * k + 2], doctest::Approx(lds2::inv_norm_cdf(res[2])));
+    }
+    pipe.reseed(0);
+    const auto res = pipe.pop();
+    CHECK_EQ(res[0], doctest::Approx(0.0));
+}
+
+TEST_CASE("Pipeline PolarDisk") {
+    auto pipe = lds2::make_pipeline(lds2::Halton(2, 3), lds2::PolarDisk());
+    auto buf = std::vector<double>(2 * 100);
+    pipe.fill(buf.data(), 100);
+    for (size_t k = 0; k != 100; ++k) {
+        CHECK_LT(std::sqrt(buf[2 * k] * buf[2 * k] +
+                           buf[2 * k + 1] * buf[2 * k + 1]),
+                 1.0);
+    }
+    // first point (0.5, 1/3): radius sqrt(0.5), angle 2 pi / 3
+    CHECK_EQ(buf[0], doctest::Approx(-0.5 * std::sqrt(0.5)));
+}
@@ -0,0 +1,38 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <lds/pmj.hpp> // for Pmj02, Pmj02Table
+#include <vector>
+
+TEST_CASE("Pmj02 stratification") {
+    auto pgen = lds2::Pmj02(7);
+    auto x = std::vector<double>(16);
+    auto y = std::vector<double>(16);
+    pgen.fill(x.data(), y.data(), 16);
+    // one sample in each elementary interval of area 1/16
+    for (size_t a = 0; a <= 4; ++a) {
+        const auto nx = double(1U << a);
+        const auto ny = double(1U << (4 - a));
+        auto cells = std::vector<int>(16, 0);
+        for (size_t k = 0; k != 16; ++k) {
+            cells[size_t(x[k] * nx) * (1U << (4 - a)) + size_t(y[k] * ny)] += 1;
+        }
+        for (auto n : cells) {
+            CHECK_EQ(n, 1);
+        }
+    }
+    const auto s = pgen.pop();
+    CHECK_EQ(s[0], doctest::Approx(x[0]));
+    CHECK_EQ(s[1], doctest::Approx(y[0]));
+}
+
+TEST_CASE("Pmj02Table") {
+    auto table = lds2::Pmj02Table(64, 3);
+    const auto pgen = lds2::Pmj02(3);
+    CHECK_EQ(table.size(), 64);
+    table.reseed(63);
+    const auto s = table.pop();
+    CHECK_EQ(s[0], doctest::Approx(pgen.at(63)[0]));
+    CHECK_EQ(s[1], doctest::Approx(pgen.at(63)[1]));
+    const auto s0 = table.pop(); // wraps around
+    CHECK_EQ(s0[0], doctest::Approx(pgen.at(0)[0]));
+}
@@ -0,0 +1,26 @@
+#include <doctest/doctest.h> // for ResultBuilder, TestCase, CHECK
+
+#include <lds/scramble.hpp> // for ScrambledVdCorput, owen_scramble
+#include <vector>
+
+TEST_CASE("reverse_bits32") {
+    CHECK_EQ(lds2::reverse_bits32(1U), 0x80000000U);
+    CHECK_EQ(lds2::reverse_bits32(0x0000000FU), 0xF0000000U);
+}
+
+TEST_CASE("ScrambledVdCorput") {
+    auto sgen = lds2::ScrambledVdCorput(7);
+    sgen.reseed(0);
+    // points 0..7 of a scrambled (0, 1)-sequence hit each eighth once
+    auto strata = std::vector<int>(8, 0);
+    strata[lds2::owen_scramble(0U, lds2::hash32(7)) >> 29U] += 1;
+    for (auto i = 0; i != 7; ++i) {
+        strata[size_t(sgen.pop() * 8.0)] += 1;
+    }
+    for (auto n : strata) {
+        CHECK_EQ(n, 1);
+    }
+    auto other = lds2::ScrambledVdCorput(8);
+    sgen.reseed(0);
+    CHECK_NE(sgen.pop(), other.pop());
+}
@@ -0,0 +1,51 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <lds/lds_n.hpp>   // for HaltonN
+#include <lds/simplex.hpp> // for fill_simplex, Dirichlet
+#include <vector>
+
+TEST_CASE("fill_simplex") {
+    auto hgen = lds2::HaltonN({2, 3, 5});
+    auto buf = std::vector<double>(3 * 3000);
+    lds2::fill_simplex(hgen, buf.data(), 3000);
+    auto mean = std::vector<double>(3, 0.0);
+    for (size_t k = 0; k != 3000; ++k) {
+        const auto *p = &buf[3 * k];
+        CHECK_EQ(p[0] + p[1] + p[2], doctest::Approx(1.0));
+        for (size_t j = 0; j != 3; ++j) {
+            CHECK_GE(p[j], 0.0);
+            mean[j] += p[j] / 3000.0;
+        }
+    }
+    for (size_t j = 0; j != 3; ++j) {
+        CHECK_EQ(mean[j], doctest::Approx(1.0 / 3.0).epsilon(0.01));
+    }
+    // the corner region p0 > 1/2 has area 1/4 of the simplex
+    auto corner = 0;
+    for (size_t k = 0; k != 3000; ++k) {
+        corner += buf[3 * k] > 0.5 ? 1 : 0;
+    }
+    CHECK_EQ(corner, doctest::Approx(750).epsilon(0.02));
+}
+
+TEST_CASE("Dirichlet") {
+    auto dgen = lds2::Dirichlet({1, 2, 3}, {2, 3, 5, 7, 11, 13});
+    CHECK_EQ(dgen.dimension(), 3);
+    auto buf = std::vector<double>(3 * 3000);
+    dgen.fill(buf.data(), 3000);
+    auto mean = std::vector<double>(3, 0.0);
+    for (size_t k = 0; k != 3000; ++k) {
+        const auto *p = &buf[3 * k];
+        CHECK_EQ(p[0] + p[1] + p[2], doctest::Approx(1.0));
+        for (size_t j = 0; j != 3; ++j) {
+            mean[j] += p[j] / 3000.0;
+        }
+    }
+    CHECK_EQ(mean[0], doctest::Approx(1.0 / 6.0).epsilon(0.01));
+    CHECK_EQ(mean[1], doctest::Approx(2.0 / 6.0).epsilon(0.01));
+    CHECK_EQ(mean[2], doctest::Approx(3.0 / 6.0).epsilon(0.01));
+    dgen.reseed(0);
+    const auto res = dgen.pop();
+    CHECK_EQ(res[0], doctest::Approx(buf[0]));
+    CHECK_EQ(res[2], doctest::Approx(buf[2]));
+}
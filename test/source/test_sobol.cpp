@@ -0,0 +1,45 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <lds/sobol.hpp> // for Sobol
+#include <vector>
+
+TEST_CASE("Sobol") {
+    auto sgen = lds2::Sobol(3);
+    const auto res = sgen.pop();
+    CHECK_EQ(res[0], doctest::Approx(0.5));
+    const auto res2 = sgen.pop();
+    CHECK_EQ(res2[0], doctest::Approx(0.75));
+    CHECK_EQ(res2[1], doctest::Approx(0.25));
+}
+
+TEST_CASE("Sobol fill and reseed") {
+    auto sgen = lds2::Sobol(300);
+    auto buf = std::vector<double>(8 * 300);
+    sgen.fill(buf.data(), 8);
+    sgen.reseed(5);
+    const auto res = sgen.pop();
+    for (size_t j = 0; j != 300; ++j) {
+        CHECK_EQ(res[j], doctest::Approx(buf[5 * 300 + j]));
+    }
+}
+
+TEST_CASE("Sobol scramble") {
+    auto sgen = lds2::Sobol(4);
+    sgen.scramble(42);
+    auto buf = std::vector<double>(16 * 4);
+    sgen.fill(buf.data(), 16);
+    // points 0..15 stay stratified in each dimension after scrambling, so
+    // points 1..16 put at most two points into each interval of width 1/16
+    auto strata = std::vector<int>(16, 0);
+    for (size_t i = 0; i != 16; ++i) {
+        CHECK_GE(buf[i * 4 + 1], 0.0);
+        CHECK_LT(buf[i * 4 + 1], 1.0);
+        strata[size_t(buf[i * 4 + 1] * 16.0)] += 1;
+    }
+    auto hits = 0;
+    for (auto n : strata) {
+        CHECK_LE(n, 2);
+        hits += n;
+    }
+    CHECK_EQ(hits, 16);
+}
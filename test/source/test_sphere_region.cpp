@@ -0,0 +1,41 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <cmath>                 // for sqrt, cos, atan2, asin
+#include <lds/sphere_region.hpp> // for SphericalCap, LatLongBand
+#include <vector>
+
+TEST_CASE("SphericalCap") {
+    auto cgen = lds2::SphericalCap({1.0, 1.0, 0.0}, 0.3, 2, 3);
+    auto buf = std::vector<double>(3 * 1000);
+    cgen.fill(buf.data(), 1000);
+    const auto r = std::sqrt(2.0);
+    auto hsum = 0.0;
+    for (size_t k = 0; k != 1000; ++k) {
+        const auto *p = &buf[3 * k];
+        CHECK_EQ(p[0] * p[0] + p[1] * p[1] + p[2] * p[2],
+                 doctest::Approx(1.0));
+        const auto h = (p[0] + p[1]) / r;
+        CHECK_GE(h, std::cos(0.3) - 1e-12);
+        hsum += h;
+    }
+    CHECK_EQ(hsum / 1000.0,
+             doctest::Approx((1.0 + std::cos(0.3)) / 2.0).epsilon(1e-4));
+    cgen.reseed(0);
+    const auto res = cgen.pop();
+    CHECK_EQ(res[2], doctest::Approx(buf[2]));
+}
+
+TEST_CASE("LatLongBand") {
+    auto bgen = lds2::LatLongBand(0.2, 0.5, 2, 3, 1.0, 2.0);
+    auto buf = std::vector<double>(3 * 500);
+    bgen.fill(buf.data(), 500);
+    for (size_t k = 0; k != 500; ++k) {
+        const auto *p = &buf[3 * k];
+        const auto lat = std::asin(p[2]);
+        const auto lon = std::atan2(p[1], p[0]);
+        CHECK_GE(lat, 0.2 - 1e-12);
+        CHECK_LE(lat, 0.5 + 1e-12);
+        CHECK_GE(lon, 1.0 - 1e-12);
+        CHECK_LE(lon, 2.0 + 1e-12);
+    }
+}
@@ -0,0 +1,57 @@
+#include <doctest/doctest.h> // for Approx, ResultBuilder, TestCase
+
+#include <lds/warp.hpp> // for Disk, Cone, CosineHemisphere, ...
+#include <vector>
+
+TEST_CASE("concentric_disk") {
+    const auto c = lds2::concentric_disk(0.5, 0.5);
+    CHECK_EQ(c[0], doctest::Approx(0.0));
+    CHECK_EQ(c[1], doctest::Approx(0.0));
+    auto dgen = lds2::Disk(2, 3);
+    const auto res = dgen.pop(); // (0.5, 1/3)
+    CHECK_EQ(res[0], doctest::Approx(0.0));
+    CHECK_EQ(res[1], doctest::Approx(-1.0 / 3.0));
+    auto buf = std::vector<double>(2 * 100);
+    dgen.reseed(0);
+    dgen.fill(buf.data(), 100);
+    for (size_t k = 0; k != 100; ++k) {
+        CHECK_LE(buf[2 * k] * buf[2 * k] + buf[2 * k + 1] * buf[2 * k + 1],
+                 1.0);
+    }
+}
+
+TEST_CASE("Cone") {
+    auto cgen = lds2::Cone(2, 3, 0.8);
+    auto buf = std::vector<double>(3 * 1000);
+    cgen.fill(buf.data(), 1000);
+    auto zsum = 0.0;
+    for (size_t k = 0; k != 1000; ++k) {
+        const auto *d = &buf[3 * k];
+        CHECK_EQ(d[0] * d[0] + d[1] * d[1] + d[2] * d[2],
+                 doctest::Approx(1.0));
+        CHECK_GE(d[2], 0.8 - 1e-12);
+        zsum += d[2];
+    }
+    CHECK_EQ(zsum / 1000.0, doctest::Approx(0.9).epsilon(1e-3));
+    cgen.reseed(999);
+    const auto last = cgen.pop();
+    CHECK_EQ(last[2], doctest::Approx(buf[3 * 999 + 2]));
+}
+
+TEST_CASE("CosineHemisphere") {
+    auto cgen = lds2::CosineHemisphere(2, 3);
+    auto buf = std::vector<double>(3 * 1000);
+    cgen.fill(buf.data(), 1000);
+    auto zsum = 0.0;
+    for (size_t k = 0; k != 1000; ++k) {
+        const auto *d = &buf[3 * k];
+        CHECK_EQ(d[0] * d[0] + d[1] * d[1] + d[2] * d[2],
+                 doctest::Approx(1.0));
+        zsum += d[2];
+    }
+    // E[cos(theta)] = 2/3 for the cosine-weighted hemisphere
+    CHECK_EQ(zsum / 1000.0, doctest::Approx(2.0 / 3.0).epsilon(1e-2));
+    cgen.reseed(999);
+    const auto last = cgen.pop();
+    CHECK_EQ(last[2], doctest::Approx(buf[3 * 999 + 2]));
+}
@@ -19,6 +19,9 @@ target("Lds")
     add_includedirs("include", {public = true})
     add_files("source/*.cpp")
     add_packages("fmt")
+    if is_plat("linux") then
+        add_syslinks("pthread")
+    end
 
 target("test_lds")
     set_kind("binary")